@@ -19,7 +19,9 @@ size(a::Array) = arraysize(a)
 size(a::Array, d) = arraysize(a, d)
 size(a::Matrix) = (arraysize(a,1), arraysize(a,2))
 length(a::Array) = arraylen(a)
-elsize{T}(a::Array{T}) = isbits(T) ? sizeof(T) : sizeof(Ptr)
+# immutables mixing plain data and references are also stored inline (see store_unboxed in array.c)
+elsize{T}(a::Array{T}) = isbits(T) ? sizeof(T) :
+    ccall(:jl_array_store_unboxed, Cint, (Any,), T) != 0 ? T.size : sizeof(Ptr)
 sizeof(a::Array) = elsize(a) * length(a)
 
 strides{T}(a::Array{T,1}) = (1,)
@@ -997,11 +999,7 @@ function vcat{T}(arrays::Array{T,1}...)
     arr = Array(T, n)
     ptr = pointer(arr)
     offset = 0
-    if isbits(T)
-        elsz = sizeof(T)
-    else
-        elsz = div(WORD_SIZE,8)
-    end
+    elsz = elsize(arr)
     for a in arrays
         nba = length(a)*elsz
         ccall(:memcpy, Ptr{Void}, (Ptr{Void}, Ptr{Void}, Uint),
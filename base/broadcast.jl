@@ -7,7 +7,7 @@ import Base.num_bit_chunks, Base.@_msk_end, Base.unsafe_bitgetindex
 import Base.(.+), Base.(.-), Base.(.*), Base.(./), Base.(.\), Base.(.//)
 import Base.(.==), Base.(.<), Base.(.!=), Base.(.<=)
 export broadcast, broadcast!, broadcast_function, broadcast!_function, bitbroadcast
-export broadcast_getindex, broadcast_setindex!
+export broadcast_getindex, broadcast_setindex!, @broadcast
 
 ## Broadcasting utilities ##
 
@@ -281,6 +281,9 @@ end
 eltype_plus(As::AbstractArray...) = promote_eltype(As...)
 eltype_plus(As::AbstractArray{Bool}...) = typeof(true+true)
 
+type_plus(T, S) = promote_type(T, S)
+type_plus(::Type{Bool}, ::Type{Bool}) = typeof(true+true)
+
 .+(As::AbstractArray...) = broadcast!(+, Array(eltype_plus(As...), broadcast_shape(As...)), As...)
 
 type_minus(T, S) = promote_type(T, S)
@@ -399,6 +402,59 @@ for (f, cachef, scalarf) in ((:.==, :bitcache_eq , :(==)),
     end
 end
 
+## fused element-wise expressions ##
+
+# dotted operator => (scalar operator, result element type)
+function fused_op(op)
+    op === :.+  ? (:+,  type_plus)    :
+    op === :.-  ? (:-,  type_minus)   :
+    op === :.*  ? (:*,  promote_type) :
+    op === :./  ? (:/,  type_div)     :
+    op === :.\  ? (:\,  type_div)     :
+    op === :.// ? (://, type_rdiv)    :
+    op === :.^  ? (:^,  type_pow)     :
+    op === :.%  ? (:%,  promote_type) :
+    nothing
+end
+
+# Turn a tree of dotted operators into a scalar expression over v_1, v_2, ...
+# and an expression for its element type over A_1, A_2, ..., collecting
+# the operands into leaves.
+function fuse_expr(ex, leaves)
+    if isa(ex,Expr) && ex.head === :call
+        op = fused_op(ex.args[1])
+        if !is(op,nothing)
+            parts = [fuse_expr(a, leaves) for a in ex.args[2:end]]
+            T = parts[1][2]
+            for i = 2:length(parts)
+                T = Expr(:call, op[2], T, parts[i][2])
+            end
+            return (Expr(:call, op[1], [p[1] for p in parts]...), T)
+        end
+    end
+    push!(leaves, ex)
+    k = length(leaves)
+    (symbol("v_$k"), Expr(:call, eltype, symbol("A_$k")))
+end
+
+# one scalar kernel per distinct expression, so that the broadcast!
+# cache is shared by every use of it
+const fused_kernels = Dict{Any,Function}()
+
+macro broadcast(args...)
+    1 <= length(args) <= 2 || error("@broadcast takes an expression and an optional destination")
+    leaves = {}
+    scalar, T = fuse_expr(args[end], leaves)
+    n = length(leaves)
+    As = [symbol("A_$k") for k = 1:n]
+    f = @get! fused_kernels scalar eval(:(function $(gensym("fused"))($([symbol("v_$k") for k = 1:n]...))
+                                              $scalar
+                                          end))
+    dest = length(args) == 2 ? esc(args[1]) : :($Array($T, $broadcast_shape($(As...))))
+    Expr(:let, Expr(:block, :($broadcast!($f, $dest, $(As...)))),
+         [:($(As[k]) = $(esc(leaves[k]))) for k = 1:n]...)
+end
+
 ## specialized element-wise operators for BitArray
 
 (.^)(A::BitArray, B::AbstractArray{Bool}) = (B .<= A)
@@ -338,6 +338,8 @@ end
 function init_parallel()
     start_gc_msgs_task()
     atexit(terminate_all_workers)
+    # hooks run last-registered first; flush before workers are told to exit
+    atexit(flush_send_bufs)
 end
 
 import .Terminals
@@ -351,6 +353,7 @@ function _start()
         init_bind_addr(ARGS)
         any(a->(a=="--worker"), ARGS) || init_head_sched()
         init_load_path()
+        init_inference_cache()
         (quiet,repl,startup,color_set,no_history_file) = process_options(copy(ARGS))
 
         local term
@@ -82,6 +82,7 @@ end
 #
 # DLMOffsets: Keep offsets (when result dimensions are not known)
 # DLMStore: Store values directly into a result store (when result dimensions are known)
+# DLMColumns: Parse numbers straight into per-column buffers (when result dimensions are not known)
 abstract DLMHandler
 
 type DLMOffsets <: DLMHandler
@@ -238,6 +239,89 @@ function result{T}(dlmstore::DLMStore{T})
     (dlmstore.hdr_offset > 0) ? (dlmstore.data, dlmstore.hdr) : dlmstore.data
 end
 
+# Only handles rectangular numeric data. Anything else (empty or missing
+# cells, ragged rows, non-numeric or escaped quoted cells) makes it give up
+# and release its buffers; readdlm then parses again with DLMOffsets.
+# This avoids keeping five offsets per cell for the common case.
+type DLMColumns{T,S<:String} <: DLMHandler
+    hdr::Vector{String}
+    cols::Vector{Vector{T}}
+
+    lastrow::Int
+    lastcol::Int
+    hdr_offset::Int
+    sbuff::S
+    eol::Char
+    ok::Bool
+    tmp64::Array{Float64,1}
+end
+
+DLMColumns{T,S<:String}(::Type{T}, has_header::Bool, sbuff::S, eol::Char) =
+    DLMColumns{T,S}(String[], Vector{T}[], 0, 0, has_header ? 1 : 0, sbuff, eol, true, Array(Float64,1))
+
+function giveup(dlmcols::DLMColumns)
+    dlmcols.ok = false
+    empty!(dlmcols.cols)
+    nothing
+end
+
+function store_cell{T,S<:String}(dlmcols::DLMColumns{T,S}, row::Int, col::Int, quoted::Bool, startpos::Int, endpos::Int)
+    dlmcols.ok || return
+    drow = row - dlmcols.hdr_offset
+    sbuff::S = dlmcols.sbuff
+
+    endpos = prevind(sbuff, nextind(sbuff,endpos))
+    (endpos > 0) && ('\n' == dlmcols.eol) && ('\r' == sbuff[endpos]) && (endpos = prevind(sbuff, endpos))
+    quoted && (startpos += 1; endpos -= 1)
+
+    if drow <= 0
+        sval = SubString(sbuff, startpos, endpos)
+        (quoted && ('"' in sval)) ? push!(dlmcols.hdr, replace(sval, r"\"\"", "\"")) : push!(dlmcols.hdr, sval)
+        return
+    end
+
+    lastrow = dlmcols.lastrow
+    lastcol = dlmcols.lastcol
+    cols = dlmcols.cols
+    if drow == lastrow
+        (col == lastcol+1) || return giveup(dlmcols)
+    elseif (drow == lastrow+1) && (col == 1)
+        ((lastrow == 0) || (lastcol == length(cols))) || return giveup(dlmcols)
+    else
+        return giveup(dlmcols)
+    end
+    if col > length(cols)
+        (drow == 1) || return giveup(dlmcols)
+        push!(cols, T[])
+    end
+
+    # parse in place; no SubString is made for the cell
+    tmp64 = dlmcols.tmp64
+    if (endpos < startpos) ||
+       ccall(:jl_substrtod, Int32, (Ptr{Uint8},Csize_t,Cint,Ptr{Float64}), sbuff, startpos-1, endpos-startpos+1, tmp64) != 0
+        return giveup(dlmcols)
+    end
+    push!(cols[col], tmp64[1])
+    dlmcols.lastrow = drow
+    dlmcols.lastcol = col
+    nothing
+end
+
+# dims are as counted by dlm_parse, which also counts rows without cells
+function result{T}(dlmcols::DLMColumns{T}, dims::NTuple{2,Int})
+    nrows = dlmcols.lastrow
+    ncols = length(dlmcols.cols)
+    if !dlmcols.ok || (nrows == 0) || (dlmcols.lastcol != ncols) || (dims != (nrows + dlmcols.hdr_offset, ncols)) ||
+       ((dlmcols.hdr_offset > 0) && (length(dlmcols.hdr) != ncols))
+        return nothing
+    end
+    data = Array(T, nrows, ncols)
+    for c in 1:ncols
+        copy!(data, (c-1)*nrows+1, dlmcols.cols[c], 1, nrows)
+    end
+    (dlmcols.hdr_offset > 0) ? (data, reshape(dlmcols.hdr, 1, ncols)) : data
+end
+
 
 function readdlm_string(sbuff::String, dlm::Char, T::Type, eol::Char, auto::Bool, optsd::Dict)
     ign_empty = (dlm == invalid_dlm)
@@ -252,6 +336,19 @@ function readdlm_string(sbuff::String, dlm::Char, T::Type, eol::Char, auto::Bool
     skipstart = get(optsd, :skipstart, 0)
     (skipstart >= 0) || error("invalid value for skipstart")
 
+    if (dims == nothing) && (T <: Number)
+        try
+            colh = DLMColumns(T, has_header, sbuff, eol)
+            data = result(colh, dlm_parse(sbuff, eol, dlm, '"', comment_char, ign_empty, quotes, comments, skipstart, colh))
+            is(data, nothing) || return data
+        catch ex
+            # conversion and parse failures fall back to the general path,
+            # which reports them; anything else (e.g. an interrupt) propagates
+            (isa(ex, InexactError) || isa(ex, MethodError) || isa(ex, ArgumentError) ||
+             isa(ex, BoundsError) || isa(ex, ErrorException)) || rethrow(ex)
+        end
+    end
+
     offset_handler = (dims == nothing) ? DLMOffsets(sbuff) : DLMStore(T, dims, has_header, sbuff, auto, eol)
 
     for retry in 1:2
@@ -385,10 +385,16 @@ function deserialize{K,V}(s, T::Type{Dict{K,V}})
     return t
 end
 
-hashindex(key, sz) = (int(hash(key)) & (sz-1)) + 1
+hashindex(key, sz) = _hashindex(hash(key), sz)
+_hashindex(hv::Uint, sz) = (int(hv) & (sz-1)) + 1
+
+# A filled slot holds 0x80 plus the top seven bits of its key's hash. Probes
+# compare this tag before calling isequal, so walking past other keys costs
+# a byte compare rather than a key comparison in almost all cases.
+_slottag(hv::Uint) = uint8(hv >>> ((sizeof(Uint)<<3)-7)) | 0x80
 
 isslotempty(h::Dict, i::Int) = h.slots[i] == 0x0
-isslotfilled(h::Dict, i::Int) = h.slots[i] == 0x1
+isslotfilled(h::Dict, i::Int) = h.slots[i] >= 0x80
 isslotmissing(h::Dict, i::Int) = h.slots[i] == 0x2
 
 function rehash{K,V}(h::Dict{K,V}, newsz)
@@ -413,14 +419,15 @@ function rehash{K,V}(h::Dict{K,V}, newsz)
     count = 0
 
     for i = 1:sz
-        if olds[i] == 0x1
+        tag = olds[i]
+        if tag >= 0x80
             k = oldk[i]
             v = oldv[i]
             index = hashindex(k, newsz)
             while slots[index] != 0
                 index = (index & (newsz-1)) + 1
             end
-            slots[index] = 0x1
+            slots[index] = tag
             keys[index] = k
             vals[index] = v
             count += 1
@@ -469,14 +476,18 @@ function ht_keyindex{K,V}(h::Dict{K,V}, key)
     sz = length(h.keys)
     iter = 0
     maxprobe = max(16, sz>>6)
-    index = hashindex(key, sz)
+    hv = hash(key)
+    index = _hashindex(hv, sz)
+    tag = _slottag(hv)
+    slots = h.slots
     keys = h.keys
 
     while true
-        if isslotempty(h,index)
+        s = slots[index]
+        if s == 0x0
             break
         end
-        if !isslotmissing(h,index) && isequal(key,keys[index])
+        if s == tag && isequal(key,keys[index])
             return index
         end
 
@@ -490,28 +501,32 @@ end
 
 # get the index where a key is stored, or -pos if not present
 # and the key would be inserted at pos
-# This version is for use by setindex! and get!
-function ht_keyindex2{K,V}(h::Dict{K,V}, key)
+# This version is for use by setindex! and get!, which pass in the key's
+# hash so that _setindex! can tag the slot without hashing the key again
+function ht_keyindex2{K,V}(h::Dict{K,V}, key, hv::Uint=hash(key))
     sz = length(h.keys)
     iter = 0
     maxprobe = max(16, sz>>6)
-    index = hashindex(key, sz)
+    index = _hashindex(hv, sz)
+    tag = _slottag(hv)
     avail = 0
+    slots = h.slots
     keys = h.keys
 
     while true
-        if isslotempty(h,index)
+        s = slots[index]
+        if s == 0x0
             avail < 0 && return avail
             return -index
         end
 
-        if isslotmissing(h,index)
+        if s == 0x2
             if avail == 0
                 # found an available slot, but need to keep scanning
                 # in case "key" already exists in a later collided slot.
                 avail = -index
             end
-        elseif isequal(key, keys[index])
+        elseif s == tag && isequal(key, keys[index])
             return index
         end
 
@@ -524,11 +539,11 @@ function ht_keyindex2{K,V}(h::Dict{K,V}, key)
 
     rehash(h, h.count > 64000 ? sz*2 : sz*4)
 
-    return ht_keyindex2(h, key)
+    return ht_keyindex2(h, key, hv)
 end
 
-function _setindex!(h::Dict, v, key, index)
-    h.slots[index] = 0x1
+function _setindex!(h::Dict, v, key, index, tag::Uint8)
+    h.slots[index] = tag
     h.keys[index] = key
     h.vals[index] = v
     h.count += 1
@@ -548,13 +563,14 @@ function setindex!{K,V}(h::Dict{K,V}, v0, key0)
     end
     v = convert(V,  v0)
 
-    index = ht_keyindex2(h, key)
+    hv = hash(key)
+    index = ht_keyindex2(h, key, hv)
 
     if index > 0
         h.keys[index] = key
         h.vals[index] = v
     else
-        _setindex!(h, v, key, -index)
+        _setindex!(h, v, key, -index, _slottag(hv))
     end
 
     return h
@@ -566,12 +582,13 @@ function get!{K,V}(h::Dict{K,V}, key0, default)
         error(key0, " is not a valid key for type ", K)
     end
 
-    index = ht_keyindex2(h, key)
+    hv = hash(key)
+    index = ht_keyindex2(h, key, hv)
 
     index > 0 && return h.vals[index]
 
     v = convert(V,  default)
-    _setindex!(h, v, key, -index)
+    _setindex!(h, v, key, -index, _slottag(hv))
     return v
 end
 
@@ -581,12 +598,13 @@ function get!{K,V}(default::Function, h::Dict{K,V}, key0)
         error(key0, " is not a valid key for type ", K)
     end
 
-    index = ht_keyindex2(h, key)
+    hv = hash(key)
+    index = ht_keyindex2(h, key, hv)
 
     index > 0 && return h.vals[index]
 
     v = convert(V,  default())
-    _setindex!(h, v, key, -index)
+    _setindex!(h, v, key, -index, _slottag(hv))
     return v
 end
 
@@ -597,11 +615,12 @@ macro get!(h, key0, default)
         K, V = eltype($(esc(h)))
         key = convert(K, $(esc(key0)))
         isequal(key, $(esc(key0))) || error($(esc(key0)), " is not a valid key for type ", K)
-        idx = ht_keyindex2($(esc(h)), key)
+        hv = hash(key)
+        idx = ht_keyindex2($(esc(h)), key, hv)
         if idx < 0
             idx = -idx
             v = convert(V, $(esc(default)))
-            _setindex!($(esc(h)), v, key, idx)
+            _setindex!($(esc(h)), v, key, idx, _slottag(hv))
         else
             @inbounds v = $(esc(h)).vals[idx]
         end
@@ -65,6 +65,7 @@ export
     PollingFileWatcher,
     ProcessGroup,
     QuickSort,
+    RadixSort,
     Range,
     RangeIndex,
     Rational,
@@ -91,6 +92,7 @@ export
     StridedMatrix,
     StridedVecOrMat,
     StridedVector,
+    StructOfArrays,
     SubArray,
     SubDArray,
     SubOrDArray,
@@ -801,6 +803,7 @@ export
     digits,
     dump,
     eachmatch,
+    eachsplit,
     endswith,
     escape_string,
     float32_isvalid,
@@ -1043,6 +1046,7 @@ export
     functionloc,
     functionlocs,
     help,
+    inlining_report,
     isconst,
     isgeneric,
     isinteractive,
@@ -1313,6 +1317,7 @@ export
     @mstr,
     @unexpected,
     @assert,
+    @broadcast,
     @cmd,
     @time,
     @timed,
@@ -1358,5 +1363,7 @@ export
     @boundscheck,
     @inbounds,
     @simd,
+    @inline,
+    @noinline,
     @label,
     @goto
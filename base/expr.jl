@@ -95,3 +95,33 @@ function localize_vars(expr, esca)
     end
     Expr(:localize, :(()->($expr)), v...)
 end
+
+## inlining hints ##
+
+# @inline and @noinline put a marker statement at the start of a method
+# body, which set_inline_hint removes once the method is defined
+function mark_inline(ex::ANY, hint::Symbol)
+    if isa(ex,Expr) && (ex.head === :function || ex.head === :(=)) &&
+        isa(ex.args[1],Expr) && ex.args[1].head === :call
+        fname = ex.args[1].args[1]
+        if isa(fname,Expr) && fname.head === :curly
+            fname = fname.args[1]
+        end
+        body = ex.args[2]
+        if isa(body,Expr) && body.head === :block
+            unshift!(body.args, QuoteNode(hint))
+        else
+            ex.args[2] = Expr(:block, QuoteNode(hint), body)
+        end
+        return Expr(:block, esc(ex), Expr(:call, set_inline_hint, esc(fname), QuoteNode(hint)))
+    end
+    error("@$hint must be applied to a method definition")
+end
+
+macro inline(ex)
+    mark_inline(ex, :inline)
+end
+
+macro noinline(ex)
+    mark_inline(ex, :noinline)
+end
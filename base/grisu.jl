@@ -46,6 +46,21 @@ function grisu_sig(x::Real, n::Integer)
     grisu(float64(x), PRECISION, int32(n))
 end
 
+# write a decimal exponent without going through a string; |e| < 1000
+function _write_exponent(io::IO, e::Int)
+    if e < 0
+        write(io, '-')
+        e = -e
+    end
+    if e >= 100
+        write(io, uint8('0'+div(e,100)))
+    end
+    if e >= 10
+        write(io, uint8('0'+rem(div(e,10),10)))
+    end
+    write(io, uint8('0'+rem(e,10)))
+end
+
 _show(io::IO, x::FloatingPoint, mode::Int32, n::Int, t) =
     _show(io, x, mode, n, t, "NaN", "Inf")
 _show(io::IO, x::Float32, mode::Int32, n::Int, t) =
@@ -82,7 +97,7 @@ function _show(io::IO, x::FloatingPoint, mode::Int32, n::Int, typed, nanstr, inf
             write(io, '0')
         end
         write(io, typed && isa(x,Float32) ? 'f' : 'e')
-        write(io, dec(pt-1))
+        _write_exponent(io, pt-1)
         if typed && isa(x,Float16) write(io, ")"); end
         return
     elseif pt <= 0
@@ -145,7 +160,7 @@ function _print_shortest(io::IO, x::FloatingPoint, dot::Bool, mode::Int32, n::In
         # => ########e###
         write(io, pdigits+0, len)
         write(io, 'e')
-        write(io, dec(e))
+        _write_exponent(io, e)
         return
     elseif pt <= 0
         # => .000########
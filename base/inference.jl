@@ -34,6 +34,11 @@ end
 
 inference_stack = EmptyCallStack()
 
+# on-disk cache of inference results (see inferencecache.jl), and the
+# method matches recorded for the entry currently being inferred
+inference_cache = nothing
+inference_deps = nothing
+
 function is_static_parameter(sv::StaticVarInfo, s::Symbol)
     sp = sv.sp
     for i=1:2:length(sp)
@@ -335,6 +340,7 @@ const getfield_tfunc = function (A, s0, name)
         fld = A[2].value
         A1 = A[1]
         if isa(A1,Module) && isdefined(A1,fld) && isconst(A1, fld)
+            is(inference_deps,nothing) || infcache_constdep(A1, fld)
             return abstract_eval_constant(eval(A1,fld))
         end
         if s === Module
@@ -548,7 +554,9 @@ function isconstantfunc(f::ANY, sv::StaticVarInfo)
     end
     if isa(f,GetfieldNode) && isa(f.value,Module)
         M = f.value; s = f.name
-        return isdefined(M,s) && isconst(M,s) && f
+        isdefined(M,s) && isconst(M,s) || return false
+        is(inference_deps,nothing) || infcache_constdep(M, s)
+        return f
     end
     if isa(f,Expr) && (is(f.head,:call) || is(f.head,:call1))
         if length(f.args) == 3 && isa(f.args[1], TopNode) &&
@@ -566,7 +574,9 @@ function isconstantfunc(f::ANY, sv::StaticVarInfo)
                     return false
                 end
             end
-            return isdefined(M,s) && isconst(M,s) && f
+            isdefined(M,s) && isconst(M,s) || return false
+            is(inference_deps,nothing) || infcache_constdep(M, s)
+            return f
         end
     end
 
@@ -667,6 +677,7 @@ function abstract_call_gf(f, fargs, argtypes, e)
     # here I picked 4.
     argtypes = limit_tuple_type(argtypes)
     applicable = _methods(f, argtypes, 4)
+    is(inference_deps,nothing) || push!(inference_deps, (f, argtypes, applicable))
     rettype = None
     if is(applicable,false)
         # this means too many methods matched
@@ -1015,6 +1026,7 @@ abstract_eval_global(s::Symbol) =
 
 function abstract_eval_global(M, s::Symbol)
     if isconst(M,s)
+        is(inference_deps,nothing) || infcache_constdep(M, s)
         return abstract_eval_constant(eval(M,s))
     end
     if !isdefined(M,s)
@@ -1024,12 +1036,36 @@ function abstract_eval_global(M, s::Symbol)
     return Any
 end
 
-function abstract_eval_symbol(s::Symbol, vtypes::ObjectIdDict, sv::StaticVarInfo)
+# types of the variables of a function at one program point, stored densely
+# by slot. unassigned slots hold NF. slots maps each variable name to its
+# index, and is shared by all the tables of a function.
+type VarTable
+    types::Array{Any,1}
+    slots::ObjectIdDict
+end
+
+VarTable(slots::ObjectIdDict, n::Int) = VarTable({ NF for i=1:n }, slots)
+
+copy(vt::VarTable) = VarTable(copy(vt.types), vt.slots)
+
+function getindex(vt::VarTable, s::Symbol)
+    i = get(vt.slots, s, 0)::Int
+    return i == 0 ? NF : vt.types[i]
+end
+
+function setindex!(vt::VarTable, t::ANY, s::Symbol)
+    vt.types[vt.slots[s]::Int] = t
+    vt
+end
+
+const emptyvartable = VarTable({}, ObjectIdDict())
+
+function abstract_eval_symbol(s::Symbol, vtypes::VarTable, sv::StaticVarInfo)
     if haskey(sv.cenv,s)
         # consider closed vars to always have their propagated (declared) type
         return sv.cenv[s]
     end
-    t = get(vtypes,s,NF)
+    t = vtypes[s]
     if is(t,NF)
         sp = sv.sp
         for i=1:2:length(sp)
@@ -1059,19 +1095,21 @@ function abstract_eval_symbol(s::Symbol, vtypes::ObjectIdDict, sv::StaticVarInfo
     return t
 end
 
-typealias VarTable ObjectIdDict
-
 type StateUpdate
     var::Symbol
+    slot::Int   # slot of var, or 0 if it is not a local variable
     vtype
     state::VarTable
 end
 
+StateUpdate(var::Symbol, vtype::ANY, state::VarTable) =
+    StateUpdate(var, get(state.slots, var, 0)::Int, vtype, state)
+
 function getindex(x::StateUpdate, s::Symbol)
     if is(x.var,s)
         return x.vtype
     end
-    return get(x.state,s,NF)
+    return x.state[s]
 end
 
 function abstract_interpret(e::ANY, vtypes, sv::StaticVarInfo)
@@ -1148,28 +1186,56 @@ end
 
 tchanged(n::ANY, o::ANY) = is(o,NF) || (!is(n,NF) && !(n <: o))
 
-stupdate(state::(), changes::VarTable, vars) = copy(changes)
-stupdate(state::(), changes::StateUpdate, vars) = stupdate(ObjectIdDict(), changes, vars)
+stupdate(state::(), changes::VarTable) = copy(changes)
+stupdate(state::(), changes::StateUpdate) =
+    stupdate(VarTable(changes.state.slots, length(changes.state.types)), changes)
 
-function stupdate(state::ObjectIdDict, changes::Union(StateUpdate,VarTable), vars)
-    for i = 1:length(vars)
-        v = vars[i]
-        newtype = changes[v]
-        oldtype = get(state::ObjectIdDict,v,NF)
+function stupdate(state::VarTable, changes::VarTable)
+    types = state.types
+    newtypes = changes.types
+    for i = 1:length(types)
+        newtype = newtypes[i]
+        oldtype = types[i]
         if tchanged(newtype, oldtype)
-            state[v] = tmerge(oldtype, newtype)
+            types[i] = tmerge(oldtype, newtype)
         end
     end
     state
 end
 
-function stchanged(new::Union(StateUpdate,VarTable), old, vars)
-    if is(old,())
-        return true
+function stupdate(state::VarTable, changes::StateUpdate)
+    types = state.types
+    newtypes = changes.state.types
+    j = changes.slot
+    for i = 1:length(types)
+        newtype = i == j ? changes.vtype : newtypes[i]
+        oldtype = types[i]
+        if tchanged(newtype, oldtype)
+            types[i] = tmerge(oldtype, newtype)
+        end
     end
-    for i = 1:length(vars)
-        v = vars[i]
-        if tchanged(new[v], get(old,v,NF))
+    state
+end
+
+stchanged(new::Union(StateUpdate,VarTable), old::()) = true
+
+function stchanged(new::VarTable, old::VarTable)
+    types = old.types
+    newtypes = new.types
+    for i = 1:length(types)
+        if tchanged(newtypes[i], types[i])
+            return true
+        end
+    end
+    return false
+end
+
+function stchanged(new::StateUpdate, old::VarTable)
+    types = old.types
+    newtypes = new.state.types
+    j = new.slot
+    for i = 1:length(types)
+        if tchanged(i == j ? new.vtype : newtypes[i], types[i])
             return true
         end
     end
@@ -1201,6 +1267,13 @@ f_argnames(ast) =
 is_rest_arg(arg::ANY) = (ccall(:jl_is_rest_arg,Int32,(Any,), arg) != 0)
 
 function typeinf_ext(linfo, atypes::ANY, sparams::ANY, def)
+    if !is(inference_cache,nothing) && tfunc_index(def, atypes) == 0
+        return typeinf_ext_cached(linfo, atypes, sparams, def)
+    end
+    typeinf_ext_uncached(linfo, atypes, sparams, def)
+end
+
+function typeinf_ext_uncached(linfo, atypes::ANY, sparams::ANY, def)
     global inference_stack
     last = inference_stack
     inference_stack = EmptyCallStack()
@@ -1214,6 +1287,42 @@ typeinf(linfo,atypes::ANY,sparams::ANY,def) = typeinf(linfo,atypes,sparams,def,t
 
 CYCLE_ID = 1
 
+# def.tfunc holds an entry of 4 slots for each signature inferred: the
+# argument types, the tree (or just the return type while recursing), the
+# "rec" flag, and the dependencies recorded for the inference cache (false
+# if none were)
+
+# index of the entry for atypes in def's t-function cache, or 0
+function tfunc_index(def, atypes::ANY)
+    tf = def.tfunc
+    if !is(tf,())
+        tfarr = tf::Array{Any,1}
+        for i = 1:4:length(tfarr)
+            if typeseq(tfarr[i],atypes)
+                return i
+            end
+        end
+    end
+    return 0
+end
+
+function tfunc_store(def, atypes::ANY, tree::ANY, rec::Bool, deps::ANY)
+    if is(def.tfunc,())
+        def.tfunc = {}
+    end
+    tfarr = def.tfunc::Array{Any,1}
+    idx = tfunc_index(def, atypes)
+    if idx == 0
+        l = length(tfarr)
+        idx = l+1
+        resize!(tfarr, l+4)
+    end
+    tfarr[idx] = atypes
+    tfarr[idx+1] = tree
+    tfarr[idx+2] = rec
+    tfarr[idx+3] = deps
+end
+
 #trace_inf = false
 #enable_trace_inf() = (global trace_inf=true)
 
@@ -1229,7 +1338,7 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
     tf = def.tfunc
     if !is(tf,())
         tfarr = tf::Array{Any,1}
-        for i = 1:3:length(tfarr)
+        for i = 1:4:length(tfarr)
             if typeseq(tfarr[i],atypes)
                 code = tfarr[i+1]
                 if tfarr[i+2]
@@ -1239,6 +1348,7 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
                     break
                 end
                 curtype = ccall(:jl_ast_rettype, Any, (Any,Any), def, code)
+                is(inference_cache,nothing) || infcache_reused(inference_cache, tfarr[i+3])
                 return (code, curtype)
             end
         end
@@ -1284,6 +1394,9 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
 
     #if dbg print("typeinf ", linfo.name, " ", atypes, "\n") end
 
+    # dependencies recorded from here on belong to this tree
+    depstart = is(inference_deps,nothing) ? -1 : length(inference_deps)
+
     if cop
         sparams = tuple(sparams..., linfo.sparams...)
         ast = ccall(:jl_prepare_ast, Any, (Any,Any), linfo, sparams)::Expr
@@ -1329,7 +1442,11 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
     # initial set of pc
     push!(W,1)
     # initial types
-    s[1] = ObjectIdDict()
+    slots = ObjectIdDict()
+    for i = 1:length(vars)
+        slots[vars[i]] = i
+    end
+    s[1] = VarTable(slots, length(vars))
     for v in vars
         s[1][v] = Undef
     end
@@ -1361,7 +1478,9 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
         vname = vi[1]
         vtype = vi[2]
         cenv[vname] = vtype
-        s[1][vname] = vtype
+        if haskey(slots, vname)
+            s[1][vname] = vtype
+        end
     end
     for vi = ((ast.args[2][2])::Array{Any,1})
         vi::Array{Any,1}
@@ -1407,9 +1526,9 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
             if !is(cur_hand,())
                 # propagate type info to exception handler
                 l = cur_hand[1]::Int
-                if stchanged(changes, s[l], vars)
+                if stchanged(changes, s[l])
                     push!(W, l)
-                    s[l] = stupdate(s[l], changes, vars)
+                    s[l] = stupdate(s[l], changes)
                 end
             end
             pc´ = pc+1
@@ -1427,9 +1546,9 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
                     else
                         # general case
                         handler_at[l] = cur_hand
-                        if stchanged(changes, s[l], vars)
+                        if stchanged(changes, s[l])
                             push!(W, l)
-                            s[l] = stupdate(s[l], changes, vars)
+                            s[l] = stupdate(s[l], changes)
                         end
                     end
                 elseif is(hd,:type_goto)
@@ -1447,7 +1566,7 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
                         # type_goto, not just any type containing it.
                         # Otherwise "None" doesn't work; see issue #3821
                         vt = changes[var]
-                        ot = get(s[l],var,NF)
+                        ot = s[l][var]
                         if ot === NF || !typeseq(vt,ot)
                             # l+1 is the statement after the label, where the
                             # static_typeof occurs.
@@ -1498,8 +1617,8 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
                 end
             end
             if pc´<=n && (handler_at[pc´] = cur_hand; true) &&
-               stchanged(changes, s[pc´], vars)
-                s[pc´] = stupdate(s[pc´], changes, vars)
+               stchanged(changes, s[pc´])
+                s[pc´] = stupdate(s[pc´], changes)
                 pc = pc´
             else
                 break
@@ -1520,34 +1639,21 @@ function typeinf(linfo::LambdaStaticData,atypes::Tuple,sparams::Tuple, def, cop)
         sv.vars = append_any(f_argnames(fulltree), fulltree.args[2][1])
         tuple_elim_pass(fulltree)
         tupleref_elim_pass(fulltree.args[3], sv)
+        constant_fold_pass(fulltree.args[3], sv)
         linfo.inferred = true
         fulltree = ccall(:jl_compress_ast, Any, (Any,Any), def, fulltree)
     end
 
+    deps = (rec || is(inference_cache,nothing)) ? false :
+        infcache_treedeps(depstart, frame.cycleid != 0)
     if !redo
-        if is(def.tfunc,())
-            def.tfunc = {}
-        end
-        tfarr = def.tfunc::Array{Any,1}
-        idx = -1
-        for i = 1:3:length(tfarr)
-            if typeseq(tfarr[i],atypes)
-                idx = i; break
-            end
-        end
-        if idx == -1
-            l = length(tfarr)
-            idx = l+1
-            resize!(tfarr, l+3)
-        end
-        tfarr[idx] = atypes
         # in the "rec" state this tree will not be used again, so store
         # just the return type in place of it.
-        tfarr[idx+1] = rec ? frame.result : fulltree
-        tfarr[idx+2] = rec
+        tfunc_store(def, atypes, rec ? frame.result : fulltree, rec, deps)
     else
         def.tfunc[tfunc_idx] = rec ? frame.result : fulltree
         def.tfunc[tfunc_idx+1] = rec
+        def.tfunc[tfunc_idx+2] = deps
     end
 
     inference_stack = (inference_stack::CallStack).prev
@@ -1655,7 +1761,7 @@ function type_annotate(ast::Expr, states::Array{Any,1}, sv::ANY, rettype::ANY,
     body = ast.args[3].args::Array{Any,1}
     for i=1:length(body)
         st_i = states[i]
-        body[i] = eval_annotate(body[i], (st_i === () ? emptydict : st_i), sv, decls, closures)
+        body[i] = eval_annotate(body[i], (st_i === () ? emptyvartable : st_i), sv, decls, closures)
     end
     ast.args[3].typ = rettype
 
@@ -1833,8 +1939,6 @@ function occurs_more(e::ANY, pred, n)
     return 0
 end
 
-const emptydict = ObjectIdDict()
-
 function exprtype(x::ANY)
     if isa(x,Expr)
         return x.typ
@@ -1847,7 +1951,7 @@ function exprtype(x::ANY)
         if is_local(sv, x)
             return Any
         end
-        return abstract_eval(x, emptydict, sv)
+        return abstract_eval(x, emptyvartable, sv)
     elseif isa(x,QuoteNode)
         v = x.value
         if isa(v,Type)
@@ -1980,7 +2084,7 @@ end
 # functions with closure environments or varargs are also excluded.
 # static parameters are ok if all the static parameter values are leaf types,
 # meaning they are fully known.
-function inlineable(f, e::Expr, atypes, sv, enclosing_ast)
+function inlineable(f, e::Expr, atypes, sv, enclosing_ast, loopdepth::Int=0)
     if !(isa(f,Function) || isstructtype(f) || isa(f,IntrinsicFunction))
         return NF
     end
@@ -2106,14 +2210,23 @@ function inlineable(f, e::Expr, atypes, sv, enclosing_ast)
     body = Expr(:block)
     body.args = without_linenums(ast.args[3].args)::Array{Any,1}
     need_mod_annotate = true
-    cost = 1.0
+    hint = get(inline_hints, linfo, :none)
+    if is(hint,:noinline)
+        inline_record(f, atypes, 0, 0, :noinline)
+        return NF
+    end
+    cost = inline_cost(body)
+    budget = inline_budget(argexprs, atypes, ty, loopdepth)
     if incompletematch
-        cost *= 4
+        budget /= 4
     end
     if is(f, next) || is(f, done)
-        cost /= 4
+        budget *= 4
     end
-    if !inline_worthy(body, cost)
+    if is(hint,:inline)
+        inline_record(f, atypes, cost, budget, :forced)
+    elseif cost > budget
+        inline_record(f, atypes, cost, budget, incompletematch ? :typeassert : :too_costly)
         if incompletematch
             # inline a typeassert-based call-site, rather than a
             # full generic lookup, using the inliner to handle
@@ -2139,6 +2252,8 @@ function inlineable(f, e::Expr, atypes, sv, enclosing_ast)
         else
             return NF
         end
+    else
+        inline_record(f, atypes, cost, budget, :inlined)
     end
 
     spnames = { sp[i].name for i=1:2:length(sp) }
@@ -2452,6 +2567,145 @@ end
 # doesn't work on Tuples of TypeVars
 const inline_incompletematch_allowed = false
 
+# LambdaStaticData => :inline or :noinline for methods defined with
+# @inline or @noinline, or :none for other methods of the same functions
+const inline_hints = ObjectIdDict()
+
+# called right after a definition marked with @inline or @noinline: the
+# macro starts the body with a marker statement, which is removed from the
+# new method here so that it is never part of any inferred or compiled code
+function set_inline_hint(f::Function, hint::Symbol)
+    d = isgeneric(f) ? f.env.defs : ()
+    while !is(d,())
+        li = d.func.code
+        if isa(li,LambdaStaticData) && !haskey(inline_hints, li)
+            inline_hints[li] = :none
+            ast = li.ast
+            if !isa(ast,Expr)
+                ast = ccall(:jl_uncompress_ast, Any, (Any,Any), li, ast)
+            end
+            body = ((ast::Expr).args[3]::Expr).args
+            i = 1
+            while i <= length(body) && (isa(body[i],LineNumberNode) ||
+                                        (isa(body[i],Expr) && is(body[i].head,:line)))
+                i += 1
+            end
+            if i <= length(body) && isa(body[i],QuoteNode) && is(body[i].value,hint)
+                splice!(body, i)
+                li.ast = isa(li.ast,Expr) ? ast :
+                    ccall(:jl_compress_ast, Any, (Any,Any), li, ast)
+                inline_hints[li] = hint
+            end
+        end
+        d = d.next
+    end
+    f
+end
+
+# units of the cost model are roughly one simple operation. a call left in
+# the callee body after its own inlining pass costs a real call, and
+# inlining saves the overhead of calling the callee itself, plus boxing of
+# tuples passed or returned, plus folding of constant arguments. the
+# budget grows with the loop depth of the call site.
+const inline_call_cost = 5
+const inline_call_overhead = 30
+const inline_box_bonus = 20
+const inline_const_bonus = 5
+const inline_max_loopdepth = 3
+
+function is_intrinsic_call(e::Expr)
+    f = e.args[1]
+    name = isa(f,TopNode) ? f.name : f
+    if isa(name,Symbol)
+        if isdefined(Core.Intrinsics,name) && isa(getfield(Core.Intrinsics,name),IntrinsicFunction)
+            return true
+        end
+        if isdefined(Core,name)
+            v = getfield(Core,name)
+            return isa(v,Function) && !isgeneric(v)
+        end
+    end
+    return false
+end
+
+function inline_cost(e::ANY, lim::Real=typemax(Int))
+    if isa(e,GotoNode)
+        return 1
+    end
+    if !isa(e,Expr)
+        return 0
+    end
+    e = e::Expr
+    if is(e.head,:line) || is(e.head,:type_goto) || is(e.head,:static_typeof)
+        return 0
+    end
+    c = 1
+    if (is(e.head,:call) || is(e.head,:call1)) && !is_intrinsic_call(e)
+        c += inline_call_cost
+    end
+    for a in e.args
+        c += inline_cost(a, lim-c)
+        if c > lim
+            break
+        end
+    end
+    return c
+end
+
+isconstantarg(a::ANY) =
+    !(isa(a,Symbol) || isa(a,SymbolNode) || isa(a,Expr) || isa(a,TopNode) ||
+      isa(a,GetfieldNode))
+
+function inline_budget(argexprs, atypes, rettype::ANY, loopdepth::Int)
+    b = inline_call_overhead
+    if isa(rettype,Tuple) && isleaftype(rettype)
+        b += inline_box_bonus
+    end
+    for i = 1:length(argexprs)
+        if isconstantarg(argexprs[i])
+            b += inline_const_bonus
+        elseif i <= length(atypes) && isa(atypes[i],Tuple) && isleaftype(atypes[i])
+            b += inline_box_bonus
+        end
+    end
+    return b * (1 + min(loopdepth, inline_max_loopdepth))
+end
+
+# loop nesting depth of each statement of a function body, where a loop
+# is the range between a label and a later backward jump to it
+function loop_depths(body::Array{Any,1})
+    n = length(body)
+    depths = zeros(Int, n)
+    labels = Dict{Int,Int}()
+    for i = 1:n
+        ex = body[i]
+        if isa(ex,LabelNode)
+            labels[ex.label] = i
+        else
+            l = isa(ex,GotoNode) ? ex.label :
+                isa(ex,Expr) && is(ex.head,:gotoifnot) ? ex.args[2] : 0
+            p = get(labels, l, 0)
+            if p > 0
+                for j = p:i
+                    depths[j] += 1
+                end
+            end
+        end
+    end
+    depths
+end
+
+# (callee, argtypes, cost, budget, decision) for each inlining decision
+# made in the function inlining_report is looking at, or nothing
+inline_report = nothing
+
+function inline_record(f, atypes, cost, budget, decision::Symbol)
+    if !is(inline_report,nothing) && isa(inference_stack,CallStack) &&
+        isa((inference_stack::CallStack).prev,EmptyCallStack)
+        push!(inline_report, (f, atypes, cost, budget, decision))
+    end
+end
+
 inline_worthy(body, cost::Real) = true
 function inline_worthy(body::Expr, cost::Real=1.0) # precondition: 0<cost
 #    if isa(body.args[1],QuoteNode) && (body.args[1]::QuoteNode).value === :inline
@@ -2489,7 +2743,8 @@ end
 
 const basenumtype = Union(Int32,Int64,Float32,Float64,Complex64,Complex128,Rational)
 
-function inlining_pass(e::Expr, sv, ast)
+# loopdepth is the loop nesting depth of e in the enclosing function body
+function inlining_pass(e::Expr, sv, ast, loopdepth::Int=0)
     if e.head == :method
         # avoid running the inlining pass on function definitions
         return (e,())
@@ -2501,11 +2756,13 @@ function inlining_pass(e::Expr, sv, ast)
     arg1 = eargs[1]
     stmts = {}
     if e.head === :body
+        depths = loop_depths(eargs)
         i = 1
+        k = 1
         while i <= length(eargs)
             ei = eargs[i]
             if isa(ei,Expr)
-                res = inlining_pass(ei, sv, ast)
+                res = inlining_pass(ei, sv, ast, loopdepth + depths[k])
                 eargs[i] = res[1]
                 if isa(res[2],Array)
                     sts = res[2]::Array{Any,1}
@@ -2516,6 +2773,7 @@ function inlining_pass(e::Expr, sv, ast)
                 end
             end
             i += 1
+            k += 1
         end
     else
         # don't inline first (global) arguments of ccall, as this needs to be evaluated
@@ -2542,7 +2800,7 @@ function inlining_pass(e::Expr, sv, ast)
                 else
                     argloc = eargs
                 end
-                res = inlining_pass(ei::Expr, sv, ast)
+                res = inlining_pass(ei::Expr, sv, ast, loopdepth)
                 res1 = res[1]
                 if has_stmts && !effect_free(res1, sv, false)
                     restype = exprtype(res1)
@@ -2606,7 +2864,7 @@ function inlining_pass(e::Expr, sv, ast)
                 if length(atypes) > MAX_TUPLETYPE_LEN
                     atypes = limit_tuple_type(atypes)
                 end
-                res = inlineable(f, e, atypes, sv, ast)
+                res = inlineable(f, e, atypes, sv, ast, loopdepth)
                 if isa(res,Tuple)
                     if isa(res[2],Array)
                         append!(stmts,res[2])
@@ -2912,6 +3170,150 @@ function tupleref_elim_pass(e::Expr, sv)
     end
 end
 
+# value of e if it is a compile-time constant, otherwise NF
+function constant_value(e::ANY)
+    if isa(e,QuoteNode)
+        return e.value
+    elseif isa(e,Number) || isa(e,Char) || isa(e,Type)
+        return e
+    elseif isa(e,Symbol) || isa(e,TopNode)
+        t = exprtype(e)
+        if isType(t) && isleaftype(t.parameters[1])
+            return t.parameters[1]
+        end
+    end
+    return NF
+end
+
+# an argument whose type can decide a comparison: evaluating it has no
+# effect and cannot fail
+function type_decides(e::ANY, sv)
+    t = exprtype(e)
+    return !is(t,None) && !is(t,Undef) &&
+        !(isa(t,UnionType) && any(x->is(x,Undef), t.types)) &&
+        effect_free(e, sv, false)
+end
+
+# whether every value of type t has exactly type t: true of leaf types,
+# except the kinds, whose values are also instances of Type{T}
+exact_type(t::ANY) = isleaftype(t) &&
+    !(is(t,DataType) || is(t,UnionType) || is(t,TypeConstructor))
+
+const fold_int_cmp = { eq_int => (==), ne_int => (!=),
+                       slt_int => (<), sle_int => (<=),
+                       ult_int => (<), ule_int => (<=) }
+
+# fold calls to pure builtins and intrinsics with constant arguments, or
+# whose result follows from the inferred types of their arguments.
+# returns the folded value, or NF.
+function fold_call(e::Expr, sv)
+    length(e.args) == 3 || return NF
+    a = e.args[2]; va = constant_value(a)
+    b = e.args[3]; vb = constant_value(b)
+    if is_known_call(e, is, sv)
+        if !is(va,NF) && !is(vb,NF)
+            return is(va,vb)
+        end
+        # typeintersect can give None for types that share values, so
+        # only an exact type rules out identity
+        if type_decides(a,sv) && type_decides(b,sv)
+            ta = exprtype(a); tb = exprtype(b)
+            if (exact_type(ta) && !(ta <: tb)) || (exact_type(tb) && !(tb <: ta))
+                return false
+            end
+        end
+    elseif is_known_call(e, isa, sv)
+        if isa(vb,Type) && type_decides(a,sv)
+            ta = exprtype(a)
+            if ta <: vb
+                return true
+            elseif exact_type(ta)
+                return false
+            end
+        end
+    elseif is_known_call(e, issubtype, sv)
+        if isa(va,Type) && isa(vb,Type)
+            return issubtype(va,vb)
+        end
+    elseif is_known_call(e, box, sv) || is_known_call(e, unbox, sv)
+        if isa(va,DataType) && isa(vb,va)
+            return vb
+        end
+    elseif is_known_call(e, and_int, sv) || is_known_call(e, or_int, sv)
+        if isa(va,Bool) && isa(vb,Bool)
+            return is_known_call(e, and_int, sv) ? (va & vb) : (va | vb)
+        end
+    elseif isa(va,Integer) && isa(vb,Integer) && is(typeof(va),typeof(vb))
+        f = isconstantfunc(e.args[1], sv)
+        f = is(f,false) ? f : _ieval(f)
+        op = get(fold_int_cmp, f, false)
+        if !is(op,false)
+            if is(f,slt_int) || is(f,sle_int)
+                isa(va,Signed) || return NF
+            elseif is(f,ult_int) || is(f,ule_int)
+                isa(va,Unsigned) || return NF
+            end
+            return op(va,vb)
+        end
+    end
+    return NF
+end
+
+function constant_fold(e::ANY, sv)
+    if !isa(e,Expr)
+        return e
+    end
+    e = e::Expr
+    for i = 1:length(e.args)
+        ei = e.args[i]
+        if isa(ei,Expr) && !is(ei.head,:method)
+            e.args[i] = constant_fold(ei, sv)
+        end
+    end
+    if is(e.head,:call)
+        if length(e.args) == 2 && is_known_call(e, not_int, sv)
+            v = constant_value(e.args[2])
+            return isa(v,Bool) ? !v : e
+        end
+        v = fold_call(e, sv)
+        if !is(v,NF)
+            return isa(v,Symbol) ? QuoteNode(v) : v
+        end
+    end
+    return e
+end
+
+# fold constants, which inlining has substituted into callee bodies, and
+# drop the branches and code this makes unreachable
+function constant_fold_pass(body::Expr, sv)
+    stmts = {}
+    dead = false
+    for st in body.args
+        if isa(st,LabelNode)
+            dead = false
+        elseif dead
+            # keep the handler structure intact
+            if !(isa(st,Expr) && (is(st.head,:enter) || is(st.head,:leave)))
+                continue
+            end
+        end
+        st = constant_fold(st, sv)
+        if isa(st,Expr) && is(st.head,:gotoifnot)
+            c = st.args[1]
+            if is(c,true)
+                continue
+            elseif is(c,false)
+                st = gn(st.args[2])
+            end
+        end
+        push!(stmts, st)
+        if isa(st,GotoNode) || (isa(st,Expr) && is(st.head,:return))
+            dead = true
+        end
+    end
+    body.args = stmts
+end
+
 # eliminate allocation of unnecessary tuples
 function tuple_elim_pass(ast::Expr)
     sv = inference_stack.sv
@@ -3003,6 +3405,25 @@ function code_typed(f::Callable, types::(Type...))
     asts
 end
 
+function inlining_report(f::Callable, types::(Type...))
+    global inline_report
+    report = {}
+    for x in _methods(f,types,-1)
+        linfo = x[3].func.code
+        # infer afresh, without disturbing the cached result
+        tf = linfo.tfunc
+        linfo.tfunc = ()
+        inline_report = report
+        try
+            typeinf(linfo, x[1], x[2])
+        finally
+            inline_report = nothing
+            linfo.tfunc = tf
+        end
+    end
+    report
+end
+
 function return_types(f::Callable, types)
     rt = {}
     for x in _methods(f,types,-1)
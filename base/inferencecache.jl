@@ -0,0 +1,279 @@
+## persistent cache of type inference results ##
+
+# Enabled by setting JULIA_INFERENCE_CACHE to a directory, or by calling
+# Base.enable_inference_cache(dir). Entries are keyed on a method and the
+# argument types it was inferred for. Each entry records the methods that
+# every call site in the inferred code dispatched to, and the constant
+# globals outside Base whose values or types inference folded into it. It
+# is discarded as soon as any of those dispatches would now select
+# different methods, or any of those constants has changed.
+#
+# A method is identified by its module, name and definition site, together
+# with the modification time of the file that defined it, so editing a
+# source file invalidates everything inferred from or against it.
+#
+# A call site whose callee was already inferred contributes no dispatches
+# of its own, so the dependencies recorded for each tree are kept next to
+# it in its method's tfunc and merged into every tree that reuses it.
+# Trees whose dependencies are not fully known (inferred inside a
+# recursive cycle, or before the cache was enabled) make their callers
+# uncacheable.
+
+type InferenceCache
+    dir::ByteString
+    srchash::ObjectIdDict    # LambdaStaticData => Uint
+    mtimes::Dict{ByteString,Float64}
+    # whether the cache was enabled before any user code was inferred, so
+    # that trees it has no record of come from the system image
+    fromstart::Bool
+end
+
+const infcache_version = string(VERSION, "-", GIT_VERSION_INFO.commit)
+
+# true while the cache itself is running, so that compiling the I/O code
+# it calls does not recur into it
+infcache_busy = false
+
+function enable_inference_cache(dir::String, fromstart::Bool=false)
+    isdir(dir) || mkpath(dir)
+    global inference_cache = InferenceCache(abspath(dir), ObjectIdDict(),
+                                            Dict{ByteString,Float64}(), fromstart)
+    nothing
+end
+
+disable_inference_cache() = (global inference_cache = nothing)
+
+function init_inference_cache()
+    dir = get(ENV, "JULIA_INFERENCE_CACHE", "")
+    isempty(dir) || enable_inference_cache(dir, true)
+end
+
+# failures reading or writing an entry that just mean "not cached": missing
+# or partial files, and entries that refer to code not loaded this session
+infcache_ioerror(ex) = isa(ex,SystemError) || isa(ex,UVError) || isa(ex,EOFError) ||
+                       isa(ex,UndefVarError) || isa(ex,TypeError) || isa(ex,ErrorException)
+
+function infcache_mtime(c::InferenceCache, file::ByteString)
+    get!(c.mtimes, file) do
+        isfile(file) ? mtime(file) : 0.0
+    end
+end
+
+# symbols hash by address, so identify a method through a string
+function infcache_ident(c::InferenceCache, li::LambdaStaticData)
+    file = string(li.file)
+    string(join(fullname(li.module), '.'), '.', li.name, '@',
+           file, ':', li.line, '@', infcache_mtime(c, file))
+end
+
+function infcache_srchash(c::InferenceCache, li::LambdaStaticData)
+    h = get(c.srchash, li, nothing)
+    if is(h,nothing)
+        h = hash(infcache_ident(c, li))
+        c.srchash[li] = h
+    end
+    h::Uint
+end
+
+# stable across sessions, unlike object_id
+function infcache_key(c::InferenceCache, def::LambdaStaticData, atypes::ANY)
+    io = IOBuffer()
+    serialize(io, atypes)
+    hash(takebuf_array(io), infcache_srchash(c, def))
+end
+
+infcache_path(c::InferenceCache, key::Uint) = joinpath(c.dir, string(num2hex(key), ".ji"))
+
+# the methods a dispatch selected, or nothing if one of them has no
+# stable identity; records merged from loaded entries are already hashed
+function infcache_matches(c::InferenceCache, applicable)
+    is(applicable,false) && return false
+    isa(applicable,Vector{Uint}) && return applicable
+    for m in applicable
+        infcache_cacheable(m[3].func.code) || return nothing
+    end
+    Uint[ infcache_srchash(c, m[3].func.code) for m in applicable ]
+end
+
+# what inference can have taken from the value of a constant: a type's
+# definition, the contents of an immutable value, and otherwise its type
+function infcache_constsig(x::ANY)
+    if isa(x,DataType)
+        hash(string(x, "<:", x.super, x.names, x.types, x.mutable, x.abstract))
+    elseif isa(x,Type)
+        hash(string(x))
+    elseif isa(x,Tuple) || isa(x,String) || isa(x,Symbol) || !typeof(x).mutable
+        io = IOBuffer()
+        serialize(io, x)
+        hash(takebuf_array(io))
+    else
+        infcache_constsig(typeof(x))
+    end
+end
+
+# the stored form of a constant dependency; false if it needs none (calls
+# through functions are covered by their dispatches), nothing if it
+# cannot be recorded
+function infcache_constrec(M::Module, s::Symbol)
+    x = getfield(M, s)
+    (isa(x,Function) || isa(x,Module)) && return false
+    try
+        return (:const, fullname(M), s, infcache_constsig(x))
+    catch ex
+        infcache_ioerror(ex) || rethrow(ex)
+        return nothing
+    end
+end
+
+function infcache_constvalid(path, s::Symbol, sig)
+    M = Main
+    for n in path
+        (isdefined(M,n) && isa(getfield(M,n),Module)) || return false
+        M = getfield(M,n)
+    end
+    isdefined(M,s) && isconst(M,s) && infcache_constsig(getfield(M,s)) == sig
+end
+
+function infcache_valid(c::InferenceCache, deps)
+    for d in deps
+        if is(d[1],:const)
+            infcache_constvalid(d[2], d[3], d[4]) || return false
+        else
+            (f, argtypes, matched) = d
+            if !isequal(infcache_matches(c, _methods(f, argtypes, 4)), matched)
+                return false
+            end
+        end
+    end
+    return true
+end
+
+# called by inference when it folds the constant M.s into a tree
+function infcache_constdep(M::Module, s::Symbol)
+    root = fullname(M)
+    if isempty(root) || !(is(root[1],:Base) || is(root[1],:Core))
+        push!(inference_deps, (M, s))
+    end
+end
+
+# called by typeinf for every tree it stores; depstart is where the
+# tree's dependencies begin in inference_deps, or -1 if none were recorded
+infcache_treedeps(depstart::Int, incycle::Bool) =
+    (depstart < 0 || incycle) ? nothing : inference_deps[depstart+1:end]
+
+# called by typeinf when a call site reuses an already inferred tree,
+# with the dependencies stored for it (false if none were recorded)
+function infcache_reused(c::InferenceCache, deps)
+    is(inference_deps,nothing) && return
+    if is(deps,false)
+        c.fromstart || push!(inference_deps, nothing)
+    elseif is(deps,nothing)
+        push!(inference_deps, nothing)
+    else
+        append!(inference_deps, deps)
+    end
+end
+
+function infcache_load(c::InferenceCache, linfo, atypes, def, key)
+    path = infcache_path(c, key)
+    isfile(path) || return nothing
+    local ident, etypes, tree, rettype, deps
+    try
+        stale = open(path) do io
+            deserialize(io) != infcache_version && return true
+            (ident, etypes, tree, rettype, deps) = deserialize(io)
+            false
+        end
+        if stale || !infcache_valid(c, deps)
+            rm(path)
+            return nothing
+        end
+    catch ex
+        infcache_ioerror(ex) || rethrow(ex)
+        return nothing
+    end
+    # a different method and signature whose key collides with this one
+    if ident != infcache_ident(c, def) || !typeseq(etypes, atypes)
+        return nothing
+    end
+    tree = ccall(:jl_compress_ast, Any, (Any,Any), def, tree)
+    tfunc_store(def, atypes, tree, false, deps)
+    linfo.inferred = true
+    return (tree, rettype)
+end
+
+function infcache_save(c::InferenceCache, def, key, atypes, tree, rettype, deps)
+    recs = {}
+    for d in unique(deps)
+        # some callee's dependencies are not known
+        is(d,nothing) && return
+        if length(d) == 2
+            rec = infcache_constrec(d[1], d[2])
+            is(rec,nothing) && return
+            is(rec,false) || push!(recs, rec)
+        elseif is(d[1],:const)
+            # already in stored form, from a loaded entry
+            push!(recs, d)
+        else
+            (f, argtypes, applicable) = d
+            matched = infcache_matches(c, applicable)
+            is(matched,nothing) && return
+            push!(recs, (f, argtypes, matched))
+        end
+    end
+    ast = ccall(:jl_uncompress_ast, Any, (Any,Any), def, tree)
+    # write to a private name first; concurrent sessions may share
+    # the directory and must never see a partial entry
+    tmp = string(infcache_path(c, key), ".", getpid())
+    try
+        open(tmp, "w") do io
+            serialize(io, infcache_version)
+            serialize(io, (infcache_ident(c, def), atypes, ast, rettype, recs))
+        end
+        mv(tmp, infcache_path(c, key))
+    catch ex
+        # not everything in an inferred tree can be serialized (e.g.
+        # pointers); such methods simply are not cached
+        infcache_ioerror(ex) || rethrow(ex)
+        isfile(tmp) && rm(tmp)
+    end
+end
+
+# methods typed at the prompt have no stable identity across sessions
+infcache_cacheable(def) = isa(def,LambdaStaticData) && def.file !== :none
+
+function typeinf_ext_cached(linfo, atypes::ANY, sparams::ANY, def)
+    global infcache_busy, inference_deps
+    if infcache_busy || !infcache_cacheable(def)
+        return typeinf_ext_uncached(linfo, atypes, sparams, def)
+    end
+    c = inference_cache::InferenceCache
+    local key, hit, result, deps
+    infcache_busy = true
+    try
+        key = infcache_key(c, def, atypes)
+        hit = infcache_load(c, linfo, atypes, def, key)
+    finally
+        infcache_busy = false
+    end
+    is(hit,nothing) || return hit
+
+    lastdeps = inference_deps
+    inference_deps = {}
+    try
+        result = typeinf_ext_uncached(linfo, atypes, sparams, def)
+    finally
+        deps = inference_deps
+        inference_deps = lastdeps
+    end
+    # trees are only compressed once inference has finished with them
+    if isa(result[1], Array{Uint8,1})
+        infcache_busy = true
+        try
+            infcache_save(c, def, key, atypes, result[1], result[2], deps)
+        finally
+            infcache_busy = false
+        end
+    end
+    result
+end
@@ -178,6 +178,19 @@ function readuntil{T}(s::IO, delim::T)
 end
 
 readline(s::IO) = readuntil(s, '\n')
+
+# read through the next delim into buf, replacing its contents
+function readuntil!(s::IO, buf::Vector{Uint8}, delim::Uint8)
+    empty!(buf)
+    while !eof(s)
+        c = read(s, Uint8)
+        push!(buf, c)
+        if c == delim
+            break
+        end
+    end
+    buf
+end
 readchomp(x) = chomp!(readall(x))
 
 # read up to nb bytes into nb, returning # bytes read
@@ -233,6 +246,24 @@ end
 next(itr::EachLine, nada) = (readline(itr.stream), nothing)
 eltype(itr::EachLine) = ByteString
 
+# Like EachLine, but each line is a view of one buffer that the next line
+# overwrites. A line must be copied (e.g. with bytestring) to keep it
+# beyond the iteration that produced it.
+type EachLineBuffer
+    stream::IO
+    buf::Vector{Uint8}
+    str::UTF8String
+end
+eachline(stream::IO, buf::Vector{Uint8}) = EachLineBuffer(stream, buf, UTF8String(buf))
+
+start(itr::EachLineBuffer) = nothing
+done(itr::EachLineBuffer, nada) = eof(itr.stream)
+function next(itr::EachLineBuffer, nada)
+    readuntil!(itr.stream, itr.buf, uint8('\n'))
+    (SubString(itr.str, 1, length(itr.buf)), nothing)
+end
+eltype(itr::EachLineBuffer) = SubString{UTF8String}
+
 readlines(s=STDIN) = collect(eachline(s))
 
 
@@ -474,6 +505,12 @@ function readuntil(s::IOStream, delim::Uint8)
     ccall(:jl_readuntil, Array{Uint8,1}, (Ptr{Void}, Uint8), s.ios, delim)
 end
 
+function readuntil!(s::IOStream, buf::Vector{Uint8}, delim::Uint8)
+    empty!(buf)
+    ccall(:jl_readuntil_into, Csize_t, (Any, Ptr{Void}, Uint8), buf, s.ios, delim)
+    buf
+end
+
 function readbytes!(s::IOStream, b::Array{Uint8}, nb=length(b))
     olb = lb = length(b)
     nr = 0
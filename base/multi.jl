@@ -96,12 +96,14 @@ type Worker
     add_msgs::Array{Any,1}
     id::Int
     gcflag::Bool
+    sendpending::Bool   # a flush of sendbuf is scheduled for this tick
+    shmem::Bool         # large bits arrays are passed in shared memory
     bind_addr::IpAddr
     manage::Function
     config::Dict
     
     Worker(host::String, port::Integer, sock::TcpSocket, id::Int) =
-        new(bytestring(host), uint16(port), sock, IOBuffer(), {}, {}, id, false)
+        new(bytestring(host), uint16(port), sock, IOBuffer(), {}, {}, id, false, false, false)
 end
 Worker(host::String, port::Integer, sock::TcpSocket) =
     Worker(host, port, sock, 0)
@@ -146,14 +148,14 @@ function flush_gc_msgs(w::Worker)
     msgs = copy(w.add_msgs)
     if !isempty(msgs)
         empty!(w.add_msgs)
-        remote_do(w, add_clients, msgs...)
+        send_msg(w, :do, add_clients, msgs)
     end
 
     msgs = copy(w.del_msgs)
     if !isempty(msgs)
         empty!(w.del_msgs)
         #print("sending delete of $msgs\n")
-        remote_do(w, del_clients, msgs...)
+        send_msg(w, :do, del_clients, msgs)
     end
 end
 
@@ -164,18 +166,62 @@ function enq_send_req(sock::TcpSocket,buf,now::Bool)
     #TODO implement "now"
 end
 
+function flush_send_buf(w::Worker)
+    w.sendpending = false
+    if nb_available(w.sendbuf) > 0
+        try
+            enq_send_req(w.socket,w.sendbuf,false)
+        catch e
+            send_failed(w.socket, w.id, e)
+        end
+    end
+end
+
+# write out everything still batched, e.g. remote_do calls made at the
+# end of a script
+function flush_send_bufs()
+    for w in (PGRP::ProcessGroup).workers
+        if isa(w,Worker)
+            flush_send_buf(w::Worker)
+        end
+    end
+end
+
+# terminate a connection that cannot be written to, otherwise the reading
+# end and any task waiting on a reply from it would hang
+function send_failed(sock::IO, wid, e)
+    print(STDERR, "fatal error on ", myid(), ": ")
+    display_error(e, catch_backtrace())
+    close(sock)
+    if myid()==1
+        rmprocs(wid)
+    elseif wid == 1
+        exit(1)
+    else
+        remote_do(1, rmprocs, wid)
+    end
+end
+
 function send_msg_(w::Worker, kind, args, now::Bool)
     #println("Sending msg $kind")
     buf = w.sendbuf
     serialize(buf, kind)
     for arg in args
-        serialize(buf, arg)
+        serialize(buf, w.shmem ? shmem_xfer_arg(w, arg) : arg)
     end
 
     if !now && w.gcflag
+        # piggyback pending GC messages on this batch
         flush_gc_msgs(w)
-    else
+    end
+    if now
+        # also writes out whatever is batched ahead of this message
         enq_send_req(w.socket,buf,now)
+    elseif !w.sendpending
+        # aggregate all messages sent to w until the sending task yields
+        # into a single socket write
+        w.sendpending = true
+        @schedule flush_send_buf(w)
     end
 end
 
@@ -250,7 +296,7 @@ function add_workers(pg::ProcessGroup, ws::Array{Any,1})
     all_locs = map(x -> isa(x, Worker) ? (string(x.bind_addr), x.port, x.id, x.manage == manage_local_worker) : ("", 0, x.id, true), pg.workers)
     
     for w in ws
-        send_msg_now(w, :join_pgrp, w.id, all_locs, w.manage == manage_local_worker)
+        send_msg_now(w, :join_pgrp, w.id, all_locs, w.manage == manage_local_worker, w.shmem)
     end
     for w in ws
         @schedule begin
@@ -307,7 +353,9 @@ function rmprocs(args...; waitfor = 0.0)
         else
             if haskey(map_pid_wrkr, i)
                 push!(rmprocset, i)
-                remote_do(i, exit)
+                # written now, along with anything still batched for i;
+                # the caller may exit before a scheduled flush would run
+                send_msg_now(worker_from_id(i), :do, exit, ())
             end
         end
     end
@@ -366,6 +414,7 @@ function register_worker(pg, w)
     if isa(w, Worker)
         map_sock_wrkr[w.socket] = w
         map_sock_wrkr[w.sendbuf] = w
+        open_ser_session(w.sendbuf)
     end
 end
 
@@ -376,6 +425,9 @@ function deregister_worker(pg, pid)
     if isa(w, Worker) 
         pop!(map_sock_wrkr, w.socket)
         pop!(map_sock_wrkr, w.sendbuf)
+        close_ser_session(w.socket)
+        close_ser_session(w.sendbuf)
+        w.shmem && shmem_xfer_cleanup(pid)
         
         # Notify the cluster manager of this workers death
         if myid() == 1
@@ -675,7 +727,8 @@ end
 function remotecall(w::Worker, f, args...)
     rr = RemoteRef(w)
     #println("$(myid()) asking for $rr")
-    send_msg(w, :call, rr2id(rr), f, args)
+    # the caller need not yield before it waits on rr, so do not batch
+    send_msg_now(w, :call, rr2id(rr), f, args)
     rr
 end
 
@@ -728,7 +781,7 @@ function remote_do(w::LocalProcess, f, args...)
 end
 
 function remote_do(w::Worker, f, args...)
-    send_msg(w, :do, f, args)
+    send_msg_now(w, :do, f, args)
     nothing
 end
 
@@ -783,21 +836,12 @@ function deliver_result(sock::IO, msg, oid, value)
         val = oid
     end
     try
-        send_msg_now(sock, :result, oid, val)
+        # batched; the handler task that called us yields when it is done,
+        # and write errors are handled by flush_send_buf
+        send_msg(sock, :result, oid, val)
     catch e
-        # terminate connection in case of serialization error
-        # otherwise the reading end would hang
-        print(STDERR, "fatal error on ", myid(), ": ")
-        display_error(e, catch_backtrace())
-        wid = worker_id_from_socket(sock)
-        close(sock)
-        if myid()==1
-            rmprocs(wid)
-        elseif wid == 1
-            exit(1)
-        else
-            remote_do(1, rmprocs, wid)
-        end
+        # serialization error
+        send_failed(sock, worker_id_from_socket(sock), e)
     end
 end
 
@@ -821,6 +865,7 @@ function create_message_handler_loop(sock::AsyncStream) #returns immediately
         global PGRP
         #println("message_handler_loop")
         disable_nagle(sock)
+        open_ser_session(sock)
         start_reading(sock)
         wait_connected(sock)
         
@@ -878,10 +923,13 @@ function create_message_handler_loop(sock::AsyncStream) #returns immediately
                     self_pid = LPROC.id = deserialize(sock)
                     locs = deserialize(sock)
                     self_is_local = deserialize(sock)
+                    self_shmem = deserialize(sock)
                     #print("\nLocation: ",locs,"\nId:",myid(),"\n")
                     # joining existing process group
                     
-                    register_worker(Worker("", 0, sock, 1))
+                    w1 = Worker("", 0, sock, 1)
+                    w1.shmem = self_shmem
+                    register_worker(w1)
                     register_worker(LPROC)
                     
                     for (rhost, rport, rpid, r_is_local) in locs
@@ -922,6 +970,7 @@ function create_message_handler_loop(sock::AsyncStream) #returns immediately
             # since currently we do not have a mechanism for workers to reconnect
             # to each other on unhandled errors
             deregister_worker(iderr)
+            close_ser_session(sock)
             
             if isopen(sock) close(sock) end
             
@@ -1051,6 +1100,7 @@ function create_worker(bind_addr, port, pubhost, stream, config, manage)
     
     w.config = config
     w.manage = manage
+    @unix_only w.shmem = get(config, :shmem, false) && is(manage, manage_local_worker)
     
     if isa(stream, AsyncStream)
         let wrker = w
@@ -1206,12 +1256,14 @@ end
 # optionally through an SSH tunnel.
 # the tunnel is only used from the head (process 1); the nodes are assumed
 # to be mutually reachable without a tunnel, as is often the case in a cluster.
+# with shmem=true, large bits-type arrays exchanged between process 1 and
+# workers on the local host are passed in shared memory segments.
 function addprocs_internal(np::Integer;
                   tunnel=false, dir=JULIA_HOME,
                   exename=(ccall(:jl_is_debugbuild,Cint,())==0?"./julia":"./julia-debug"),
-                  sshflags::Cmd=``, cman=LocalManager(), exeflags=``)
+                  sshflags::Cmd=``, cman=LocalManager(), exeflags=``, shmem=false)
                   
-    config={:dir=>dir, :exename=>exename, :exeflags=>`$exeflags --worker`, :tunnel=>tunnel, :sshflags=>sshflags}
+    config={:dir=>dir, :exename=>exename, :exeflags=>`$exeflags --worker`, :tunnel=>tunnel, :sshflags=>sshflags, :shmem=>shmem}
     disable_threaded_libs()
     add_workers(PGRP, start_cluster_workers(np, config, cman))
 end
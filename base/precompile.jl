@@ -76,15 +76,15 @@ precompile(_atexit, ())
 precompile(read, (IOStream, Array{Uint32,1}))
 precompile(hex, (Char, Int))
 precompile(abs, (Char,))
-precompile(abstract_eval, (LambdaStaticData, ObjectIdDict, StaticVarInfo))
+precompile(abstract_eval, (LambdaStaticData, VarTable, StaticVarInfo))
 precompile(length, (UnitRange{Int},))
 precompile(start, (UnitRange{Int},))
 precompile(done, (UnitRange{Int},Int))
 precompile(next, (UnitRange{Int},Int))
 precompile(IOStream, (ASCIIString, Array{Uint8,1}))
 precompile(mk_tupleref, (SymbolNode, Int))
-precompile(abstract_interpret, (Bool, ObjectIdDict, StaticVarInfo))
-precompile(eval_annotate, (LambdaStaticData, ObjectIdDict, StaticVarInfo, ObjectIdDict, Array{Any,1}))
+precompile(abstract_interpret, (Bool, VarTable, StaticVarInfo))
+precompile(eval_annotate, (LambdaStaticData, VarTable, StaticVarInfo, ObjectIdDict, Array{Any,1}))
 precompile(occurs_more, (Bool, Function, Int))
 precompile(isconstantfunc, (SymbolNode, StaticVarInfo))
 precompile(CallStack, (Expr, Module, (Nothing,), EmptyCallStack))
@@ -109,7 +109,7 @@ precompile(unshift!, (Array{Any,1}, Task))
 precompile(nnz, (BitArray{1},))
 precompile(get_chunks_id, (Int,))
 precompile(occurs_more, (Uint8, Function, Int))
-precompile(abstract_eval_arg, (Uint8, ObjectIdDict, StaticVarInfo))
+precompile(abstract_eval_arg, (Uint8, VarTable, StaticVarInfo))
 precompile(occurs_outside_tupleref, (Function, Symbol, StaticVarInfo, Int))
 precompile(search, (ASCIIString, Regex, Int))
 precompile(setindex!, (Vector{Any}, Uint8, Int))
@@ -165,7 +165,7 @@ precompile(print, (IOBuffer, UTF8String))
 precompile(VersionNumber, (Int, Int, Int, (), (ASCIIString,)))
 precompile(print, (Terminals.TTYTerminal, ASCIIString))
 precompile(-, (Int,))
-precompile(_setindex!, (Dict{Any, Any}, Bool, WeakRef, Int))
+precompile(_setindex!, (Dict{Any, Any}, Bool, WeakRef, Int, Uint8))
 precompile(REPL.LineEditREPL, (Terminals.TTYTerminal,))
 precompile(input_color, ())
 precompile(async_run_thunk, (Function,))
@@ -210,10 +210,10 @@ precompile(search, (IOBuffer, Uint8))
 precompile(read, (IOBuffer, Type{Char}))
 precompile(read, (IOBuffer, Type{Uint8}))
 precompile(LineEdit.write_prompt, (Terminals.TTYTerminal, LineEdit.PromptState, ASCIIString))
-precompile(ht_keyindex2, (Dict{Uint8, Any}, Uint8))
+precompile(ht_keyindex2, (Dict{Uint8, Any}, Uint8, Uint))
 precompile(rehash, (Dict{Uint8, Any}, Int))
 precompile(setindex!, (Dict{Uint8, Any}, LineEdit.Prompt, Uint8))
-precompile(_setindex!, (Dict{Uint8, Any}, LineEdit.Prompt, Uint8, Int))
+precompile(_setindex!, (Dict{Uint8, Any}, LineEdit.Prompt, Uint8, Int, Uint8))
 precompile(keys, (Dict{Uint8, Any},))
 precompile(in, (Uint8, KeyIterator{Dict{Uint8, Any}}))
 precompile(ht_keyindex, (Dict{Uint8, Any}, Uint8))
@@ -230,12 +230,12 @@ precompile(done, (Array{LineEdit.TextInterface, 1}, Int))
 precompile(next, (Array{LineEdit.TextInterface, 1}, Int))
 precompile(LineEdit.init_state, (Terminals.TTYTerminal, LineEdit.Prompt))
 precompile(setindex!, (Dict{Any, Any}, LineEdit.PromptState, LineEdit.Prompt))
-precompile(ht_keyindex2, (Dict{Any, Any}, LineEdit.Prompt))
-precompile(_setindex!, (Dict{Any, Any}, LineEdit.PromptState, LineEdit.Prompt, Int))
+precompile(ht_keyindex2, (Dict{Any, Any}, LineEdit.Prompt, Uint))
+precompile(_setindex!, (Dict{Any, Any}, LineEdit.PromptState, LineEdit.Prompt, Int, Uint8))
 precompile(LineEdit.init_state, (Terminals.TTYTerminal, LineEdit.HistoryPrompt))
 precompile(setindex!, (Dict{Any, Any}, LineEdit.SearchState, LineEdit.HistoryPrompt))
-precompile(ht_keyindex2, (Dict{Any, Any}, LineEdit.HistoryPrompt))
-precompile(_setindex!, (Dict{Any, Any}, LineEdit.SearchState, LineEdit.HistoryPrompt, Int))
+precompile(ht_keyindex2, (Dict{Any, Any}, LineEdit.HistoryPrompt, Uint))
+precompile(_setindex!, (Dict{Any, Any}, LineEdit.SearchState, LineEdit.HistoryPrompt, Int, Uint8))
 precompile(LineEdit.activate, (LineEdit.Prompt, LineEdit.MIState))
 precompile(isequal, (LineEdit.Prompt, LineEdit.Prompt))
 precompile(getindex, (Dict{Any, Any}, LineEdit.Prompt))
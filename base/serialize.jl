@@ -5,8 +5,12 @@ abstract LongSymbol
 abstract LongTuple
 abstract LongExpr
 abstract UndefRefTag
+# per-connection session references, see SerializationSession
+abstract SessionDefTag
+abstract SessionRefTag
+abstract SessionTypeTag
 
-const ser_version = 1 # do not make changes without bumping the version #!
+const ser_version = 3 # do not make changes without bumping the version #!
 const ser_tag = ObjectIdDict()
 const deser_tag = ObjectIdDict()
 let i = 2
@@ -18,7 +22,7 @@ let i = 2
              LineNumberNode, SymbolNode, LabelNode, GotoNode,
              QuoteNode, TopNode, TypeVar, Box, LambdaStaticData,
              Module, UndefRefTag, Task, ASCIIString, UTF8String,
-             :reserved6, :reserved7, :reserved8,
+             SessionDefTag, SessionRefTag, SessionTypeTag,
              :reserved9, :reserved10, :reserved11, :reserved12,
              
              (), Bool, Any, :Any, None, Top, Undef, Type,
@@ -31,8 +35,10 @@ let i = 2
              :mul_float, :unbox, :box,
              :eq_int, :slt_int, :sle_int, :ne_int,
              :arrayset, :arrayref,
-             :Core, :Base, :reserved15, :reserved16,
-             :reserved17, :reserved18, :reserved19, :reserved20,
+             :Core, :Base,
+             # message kinds used by multi.jl, so each message header is 1 byte
+             :call_fetch, :call_wait, :result, :do,
+             :identify_socket, :join_pgrp,
              false, true, nothing, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
              12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27,
              28, 29, 30, 31, 32}
@@ -47,6 +53,49 @@ const VALUE_TAGS = ser_tag[()]
 
 writetag(s, x) = write(s, uint8(ser_tag[x]))
 
+## per-connection serialization state ##
+
+# Streams with an open session send each DataType, Symbol and Module only
+# once; later occurrences are written as a reference to its id in the
+# session. Both ends of a stream must open a session before any data
+# is exchanged on it.
+type SerializationSession
+    ids::ObjectIdDict    # object => id, when serializing
+    objs::Array{Any,1}   # id => object
+    buf::Array{Uint8,1}  # scratch space for reading symbol names
+
+    SerializationSession() = new(ObjectIdDict(), {}, Array(Uint8,0))
+end
+
+# held weakly, so that a stream dropped without close_ser_session does
+# not keep its session alive
+const ser_sessions = WeakKeyDict()
+
+open_ser_session(s) = (ser_sessions[s] = SerializationSession(); nothing)
+close_ser_session(s) = (delete!(ser_sessions, s); nothing)
+
+# write x as a reference into the session of s, defining it first if
+# needed. returns false if s has no session.
+function write_session_ref(s, x, reftag)
+    sess = get(ser_sessions, s, nothing)
+    if is(sess, nothing)
+        return false
+    end
+    sess = sess::SerializationSession
+    id = get(sess.ids, x, 0)::Int
+    if id == 0
+        writetag(s, SessionDefTag)
+        serialize_uncached(s, x)
+        # x might refer to other new entries, which are numbered first
+        push!(sess.objs, x)
+        id = length(sess.objs)
+        sess.ids[x] = id
+    end
+    writetag(s, reftag)
+    write(s, int32(id))
+    true
+end
+
 function write_as_tag(s, x)
     t = ser_tag[x]
     if t < VALUE_TAGS
@@ -79,6 +128,10 @@ function serialize(s, x::Symbol)
     if haskey(ser_tag, x)
         return write_as_tag(s, x)
     end
+    write_session_ref(s, x, SessionRefTag) || serialize_uncached(s, x)
+end
+
+function serialize_uncached(s, x::Symbol)
     pname = convert(Ptr{Uint8}, x)
     ln = int(ccall(:strlen, Csize_t, (Ptr{Uint8},), pname))
     if ln <= 255
@@ -161,7 +214,10 @@ function serialize(s, e::Expr)
     end
 end
 
-function serialize(s, m::Module)
+serialize(s, m::Module) =
+    write_session_ref(s, m, SessionRefTag) || serialize_uncached(s, m)
+
+function serialize_uncached(s, m::Module)
     writetag(s, Module)
     serialize(s, fullname(m))
 end
@@ -267,17 +323,21 @@ end
 function serialize(s, t::DataType)
     if haskey(ser_tag,t)
         write_as_tag(s, t)
-    else
-        writetag(s, DataType)
-        write(s, uint8(0))
-        serialize_type_data(s, t)
+    elseif !write_session_ref(s, t, SessionRefTag)
+        serialize_uncached(s, t)
     end
 end
 
+function serialize_uncached(s, t::DataType)
+    writetag(s, DataType)
+    write(s, uint8(0))
+    serialize_type_data(s, t)
+end
+
 function serialize_type(s, t::DataType)
     if haskey(ser_tag,t)
         writetag(s, t)
-    else
+    elseif !write_session_ref(s, t, SessionTypeTag)
         writetag(s, DataType)
         write(s, uint8(1))
         serialize_type_data(s, t)
@@ -292,6 +352,9 @@ function serialize(s, x)
     serialize_type(s, t)
     if length(t.names)==0 && t.size>0
         write(s, x)
+    elseif isbits(t) && t.size>0
+        # immutable of bits fields: write its memory in one go
+        write(s, convert(Ptr{Uint8}, pointer_from_objref(x) + sizeof(Ptr{Void})), t.size)
     else
         serialize(s, length(t.names))
         for i in 1:length(t.names)
@@ -329,8 +392,32 @@ end
 
 deserialize_tuple(s, len) = ntuple(len, i->deserialize(s))
 
-deserialize(s, ::Type{Symbol}) = symbol(read(s, Uint8, int32(read(s, Uint8))))
-deserialize(s, ::Type{LongSymbol}) = symbol(read(s, Uint8, read(s, Int32)))
+deserialize(s, ::Type{Symbol}) = deserialize_symbol(s, int(read(s, Uint8)))
+deserialize(s, ::Type{LongSymbol}) = deserialize_symbol(s, int(read(s, Int32)))
+
+function deserialize_symbol(s, len::Int)
+    sess = get(ser_sessions, s, nothing)
+    if is(sess, nothing)
+        return symbol(read(s, Uint8, len))
+    end
+    buf = (sess::SerializationSession).buf
+    resize!(buf, len)
+    read!(s, buf)
+    ccall(:jl_symbol_n, Any, (Ptr{Uint8}, Int32), buf, len)::Symbol
+end
+
+function deserialize(s, ::Type{SessionDefTag})
+    sess = ser_sessions[s]::SerializationSession
+    push!(sess.objs, deserialize(s))
+    # a definition is always followed by a reference to it
+    deserialize(s)
+end
+
+deserialize(s, ::Type{SessionRefTag}) =
+    (ser_sessions[s]::SerializationSession).objs[read(s, Int32)]
+
+deserialize(s, ::Type{SessionTypeTag}) =
+    deserialize(s, (ser_sessions[s]::SerializationSession).objs[read(s, Int32)]::DataType)
 
 function deserialize(s, ::Type{Module})
     path = deserialize(s)
@@ -490,11 +577,23 @@ function deserialize(s, ::Type{Task})
     t
 end
 
+# fill nb bytes at p, e.g. the memory of a newly allocated isbits immutable
+function read_raw!(s, p::Ptr{Uint8}, nb::Int)
+    for i = 1:nb
+        unsafe_store!(p, read(s, Uint8), i)
+    end
+end
+read_raw!(s::IOBuffer, p::Ptr{Uint8}, nb::Int) = read!(s, p, nb)
+
 # default DataType deserializer
 function deserialize(s, t::DataType)
     if length(t.names)==0 && t.size>0
         # bits type
         return read(s, t)
+    elseif isbits(t) && t.size>0
+        x = ccall(:jl_new_struct_uninit, Any, (Any,), t)
+        read_raw!(s, convert(Ptr{Uint8}, pointer_from_objref(x) + sizeof(Ptr{Void})), t.size)
+        return x
     end
     nf_expected = deserialize(s)
     nf = length(t.names)
@@ -332,6 +332,78 @@ function print_shmem_limits(slen)
     end
 end
 
+## passing large arrays to local workers in shared memory ##
+
+# Processes connected with addprocs(...; shmem=true) hand over bits-type
+# arrays of at least this many bytes in a shared memory segment, instead of
+# writing their contents through the socket. This applies to arrays passed
+# directly as message arguments, or inside tuples (e.g. remotecall
+# arguments and results). The receiver maps the segment in place, unlinks
+# it and acknowledges it. Until then the sender keeps the segment's name,
+# so it can unlink it if the receiver goes away first.
+const SHMEM_XFER_MIN_BYTES = 64*1024
+
+type ShmemArrayXfer
+    T::DataType
+    dims::Dims
+    segname::ByteString
+end
+
+# segments sent but not yet acknowledged, with the pid they were sent to
+const shmem_xfer_pending = Dict{ByteString,Int}()
+
+let next_xfer = 1
+    global shmem_xfer_segname
+    function shmem_xfer_segname()
+        if next_xfer == 1
+            atexit(()->shmem_xfer_cleanup(0))
+        end
+        # On OSX, the shm_seg_name length must be < 32 characters
+        segname = string("/jlx", getpid(), "_", next_xfer)
+        next_xfer += 1
+        segname
+    end
+end
+
+# called by send_msg_ on each argument of a message to a worker with shmem
+shmem_xfer_arg(w::Worker, x) = x
+shmem_xfer_arg(w::Worker, t::Tuple) = map(x->shmem_xfer_arg(w, x), t)
+function shmem_xfer_arg{T}(w::Worker, a::Array{T})
+    if !isbits(T) || length(a)*sizeof(T) < SHMEM_XFER_MIN_BYTES
+        return a
+    end
+    segname = shmem_xfer_segname()
+    seg = shm_mmap_array(T, size(a), segname, JL_O_CREAT | JL_O_RDWR)
+    copy!(seg, a)
+    shmem_xfer_pending[segname] = w.id
+    ShmemArrayXfer(T, size(a), segname)
+end
+
+function deserialize(s, t::Type{ShmemArrayXfer})
+    x = invoke(deserialize, (Any, DataType), s, t)
+    local A
+    try
+        A = shm_mmap_array(x.T, x.dims, x.segname, JL_O_RDWR)
+    finally
+        shm_unlink(x.segname)
+    end
+    remote_do(worker_id_from_socket(s), shmem_xfer_done, x.segname)
+    A
+end
+
+shmem_xfer_done(segname) = (delete!(shmem_xfer_pending, segname); nothing)
+
+# unlink the segments still pending for pid, or for every pid if pid is 0
+function shmem_xfer_cleanup(pid::Int)
+    for (segname, topid) in collect(shmem_xfer_pending)
+        if pid == 0 || topid == pid
+            # the receiver may already have unlinked it
+            ccall(:shm_unlink, Cint, (Ptr{Uint8},), segname)
+            delete!(shmem_xfer_pending, segname)
+        end
+    end
+end
+
 # utilities
 function shm_mmap_array(T, dims, shm_seg_name, mode)
     local s = nothing
@@ -25,7 +25,8 @@ export # also exported by Base
     # algorithms:
     InsertionSort,
     QuickSort,
-    MergeSort
+    MergeSort,
+    RadixSort
 
 export # not exported by Base
     Algorithm,
@@ -215,10 +216,12 @@ abstract Algorithm
 immutable InsertionSortAlg <: Algorithm end
 immutable QuickSortAlg     <: Algorithm end
 immutable MergeSortAlg     <: Algorithm end
+immutable RadixSortAlg     <: Algorithm end
 
 const InsertionSort = InsertionSortAlg()
 const QuickSort     = QuickSortAlg()
 const MergeSort     = MergeSortAlg()
+const RadixSort     = RadixSortAlg()
 
 const DEFAULT_UNSTABLE = QuickSort
 const DEFAULT_STABLE   = MergeSort
@@ -308,6 +311,73 @@ function sort!(v::AbstractVector, lo::Int, hi::Int, a::MergeSortAlg, o::Ordering
     return v
 end
 
+# LSD radix sort on the unsigned keys given by uint_mapping. It is stable,
+# and only works for orderings that such a key can express.
+const RADIX_SIZE = 11
+const RADIX_MASK = 0x7FF
+
+radixkey(o::Ordering, x) = uint_mapping(o, x)
+radixkey(o::ReverseOrdering, x) = ~radixkey(o.fwd, x)
+radixkey(o::By, x) = radixkey(Forward, o.by(x))
+radixkey(o::Perm, i::Int) = radixkey(o.order, o.data[i])
+# all NaNs are equal to isless, so give them one key to keep them in order
+radixkey{T<:Union(Float32,Float64)}(o::ForwardOrdering, x::T) =
+    uint_mapping(o, x != x ? convert(T,NaN) : x)
+
+function sort!(v::AbstractVector, lo::Int, hi::Int, a::RadixSortAlg, o::Ordering)
+    hi-lo <= SMALL_THRESHOLD && return sort!(v, lo, hi, SMALL_ALGORITHM, o)
+    k = radixkey(o, v[lo])
+    ks = Array(typeof(k), hi-lo+1)
+    @inbounds for i = lo:hi
+        ks[i-lo+1] = radixkey(o, v[i])
+    end
+    radix_sort!(v, lo, hi, ks)
+end
+
+function radix_sort!{U<:Unsigned}(v::AbstractVector, lo::Int, hi::Int, ks::Vector{U})
+    n = length(ks)
+    iters = div(sizeof(U)*8 + RADIX_SIZE-1, RADIX_SIZE)
+    bin = zeros(Int, 1<<RADIX_SIZE, iters)
+
+    # count the digits of every pass at once
+    @inbounds for i = 1:n
+        k = ks[i]
+        for j = 1:iters
+            bin[int((k >> ((j-1)*RADIX_SIZE)) & RADIX_MASK) + 1, j] += 1
+        end
+    end
+
+    vs = v[lo:hi]
+    ts = similar(vs)
+    tk = similar(ks)
+    @inbounds for j = 1:iters
+        shift = (j-1)*RADIX_SIZE
+        # nothing moves in a pass where all keys share the digit
+        bin[int((ks[1] >> shift) & RADIX_MASK) + 1, j] == n && continue
+
+        c = 0
+        for b = 1:(1<<RADIX_SIZE)
+            c += bin[b,j]
+            bin[b,j] = c
+        end
+        for i = n:-1:1
+            k = ks[i]
+            d = int((k >> shift) & RADIX_MASK) + 1
+            p = bin[d,j]
+            ts[p] = vs[i]
+            tk[p] = k
+            bin[d,j] = p-1
+        end
+        vs, ts = ts, vs
+        ks, tk = tk, ks
+    end
+
+    @inbounds for i = 1:n
+        v[lo+i-1] = vs[i]
+    end
+    return v
+end
+
 ## generic sorting methods ##
 
 defalg(v::AbstractArray) = DEFAULT_STABLE
@@ -351,7 +421,7 @@ using ..Sort
 using ...Order
 
 import Core.Intrinsics: unbox, slt_int
-import ..Sort: sort!
+import ..Sort: sort!, RadixSortAlg
 import ...Order: lt, DirectOrdering, uint_mapping
 
 typealias Floats Union(Float32,Float64)
@@ -428,6 +498,10 @@ end
 sort!{T<:Floats}(v::AbstractVector{T}, a::Algorithm, o::DirectOrdering) = fpsort!(v,a,o)
 sort!{O<:DirectOrdering,T<:Floats}(v::Vector{Int}, a::Algorithm, o::Perm{O,Vector{T}}) = fpsort!(v,a,o)
 
+# radix keys already order NaNs and signed zeros
+sort!{T<:Floats}(v::AbstractVector{T}, a::RadixSortAlg, o::DirectOrdering) = sort!(v,1,length(v),a,o)
+sort!{O<:DirectOrdering,T<:Floats}(v::Vector{Int}, a::RadixSortAlg, o::Perm{O,Vector{T}}) = sort!(v,1,length(v),a,o)
+
 end # module Sort.Float
 
 end # module Sort
@@ -294,6 +294,42 @@ function _searchindex(s::Array, t::Array, i)
     0
 end
 
+# byte arrays: memchr jumps to each occurrence of the first byte of t, and
+# memcmp checks the rest of t there
+function _searchindex{T<:Union(Int8,Uint8)}(s::Array{T,1}, t::Array{T,1}, i)
+    n = length(t)
+    m = length(s)
+
+    if n == 0
+        return 1 <= i <= m+1 ? max(1, i) : 0
+    elseif m == 0
+        return 0
+    elseif n == 1
+        return search(s, t[1], i)
+    end
+
+    w = m - n
+    if w < 0 || i - 1 > w
+        return 0
+    end
+
+    i = max(i, 1)
+    ps = pointer(s)
+    pt = pointer(t)
+    t1 = t[1]
+    while i <= w+1
+        q = ccall(:memchr, Ptr{T}, (Ptr{T}, Int32, Csize_t), ps+i-1, t1, w+2-i)
+        q == C_NULL && return 0
+        i = int(q-ps)+1
+        if ccall(:memcmp, Int32, (Ptr{T}, Ptr{T}, Csize_t), q+1, pt+1, n-1) == 0
+            return i
+        end
+        i += 1
+    end
+
+    0
+end
+
 searchindex(s::Union(Array{Uint8,1},Array{Int8,1}),t::Union(Array{Uint8,1},Array{Int8,1}),i) = _searchindex(s,t,i)
 searchindex(s::String, t::String, i::Integer) = _searchindex(s,t,i)
 searchindex(s::String, t::String) = searchindex(s,t,start(s))
@@ -1292,6 +1328,50 @@ split(s::String, spl)             = split(s, spl, 0, true)
 const _default_delims = [' ','\t','\n','\v','\f','\r']
 split(str::String)                = split(str, _default_delims, 0, false)
 
+# lazy version of split: yields the pieces one at a time, without
+# building an array of them
+immutable EachSplit{T<:String,S}
+    str::T
+    splitter::S
+    keep_empty::Bool
+end
+eachsplit(str::String, splitter, keep_empty::Bool) = EachSplit(str, splitter, keep_empty)
+eachsplit(str::String, splitter) = EachSplit(str, splitter, true)
+eachsplit(str::String)           = EachSplit(str, _default_delims, false)
+
+eltype{T}(::EachSplit{T}) = SubString{T}
+eltype{T<:SubString}(::EachSplit{T}) = T
+
+# the state is (next piece, start of the piece after it, search position);
+# a piece start of 0 means the end of the string has been reached
+function _splitnext(itr::EachSplit, i::Int, k::Int)
+    str = itr.str
+    n = endof(str)
+    while i > 0
+        r = search(str,itr.splitter,k)
+        j, e = first(r), nextind(str,last(r))
+        if !(0 < j <= n)
+            if itr.keep_empty || !done(str,i)
+                return (SubString(str,i), 0, 0)
+            end
+            break
+        end
+        s = i
+        emit = false
+        if i < e
+            emit = itr.keep_empty || i < j
+            i = e
+        end
+        k = e <= j ? nextind(str,j) : e
+        emit && return (SubString(str,s,prevind(str,j)), i, k)
+    end
+    (nothing, 0, 0)
+end
+
+start(itr::EachSplit) = _splitnext(itr, start(itr.str), start(itr.str))
+done(itr::EachSplit, st) = is(st[1],nothing)
+next(itr::EachSplit, st) = (st[1], _splitnext(itr, st[2], st[3]))
+
 
 rsplit{T<:SubString}(str::T, splitter, limit::Integer, keep_empty::Bool) = _rsplit(str, splitter, limit, keep_empty, T[])
 rsplit{T<:String}(str::T, splitter, limit::Integer, keep_empty::Bool) = _rsplit(str, splitter, limit, keep_empty, SubString{T}[])
@@ -0,0 +1,81 @@
+## struct-of-arrays storage for immutables ##
+
+# A StructOfArrays{T} keeps one column array per field of the immutable type
+# T instead of an array of whole records, so a loop that only reads some of
+# the fields touches contiguous memory and can be vectorized. Indexing
+# assembles or scatters a T through methods generated per number of fields,
+# so the loads and stores are unrolled and the record is built without
+# boxing its fields.
+
+type StructOfArrays{T,N,C<:Tuple} <: AbstractArray{T,N}
+    arrays::C
+
+    StructOfArrays(arrays::C) = new(arrays)
+end
+
+function soa_check(T::DataType)
+    if T.mutable || isempty(T.names) || !isleaftype(T)
+        error("StructOfArrays: element type must be an immutable concrete type with fields")
+    end
+end
+soa_check(T) = error("StructOfArrays: element type must be an immutable concrete type with fields")
+
+function StructOfArrays(T::Type, dims::Dims)
+    soa_check(T)
+    arrays = ntuple(length(T.types), k->Array(T.types[k], dims))
+    StructOfArrays{T,length(dims),typeof(arrays)}(arrays)
+end
+StructOfArrays(T::Type, dims::Int...) = StructOfArrays(T, dims)
+
+function convert{T}(::Type{StructOfArrays}, A::AbstractArray{T})
+    S = StructOfArrays(T, size(A))
+    for i = 1:length(A)
+        S[i] = A[i]
+    end
+    S
+end
+convert(::Type{StructOfArrays}, A::StructOfArrays) = A
+
+size(A::StructOfArrays) = size(A.arrays[1])
+size(A::StructOfArrays, d) = size(A.arrays[1], d)
+length(A::StructOfArrays) = length(A.arrays[1])
+
+similar(A::StructOfArrays, T::DataType, dims::Dims) =
+    (!T.mutable && !isempty(T.names) && isleaftype(T)) ? StructOfArrays(T, dims) : Array(T, dims)
+similar(A::StructOfArrays, T, dims::Dims) = Array(T, dims)
+
+getindex(A::StructOfArrays, i::Real) = getindex(A, to_index(i))
+getindex(A::StructOfArrays, i::Real, j::Real) = getindex(A, sub2ind(size(A), to_index(i), to_index(j)))
+
+function getindex{T}(A::StructOfArrays{T}, i::Int)
+    1 <= i <= length(A) || throw(BoundsError())
+    soa_getindex(T, i, A.arrays...)
+end
+
+setindex!{T}(A::StructOfArrays{T}, x, i::Real) = setindex!(A, convert(T,x)::T, to_index(i))
+setindex!(A::StructOfArrays, x, i::Real, j::Real) = setindex!(A, x, sub2ind(size(A), to_index(i), to_index(j)))
+
+function setindex!{T}(A::StructOfArrays{T}, x::T, i::Int)
+    1 <= i <= length(A) || throw(BoundsError())
+    soa_setindex!(x, i, A.arrays...)
+    A
+end
+
+# cols_k holds field k; records with more fields than are generated here
+# get their methods from ngenerate's cache on first use
+soa_getindex_body(NF::Int) = quote
+    @inbounds x = $(Expr(:new, :T, [:($(symbol(string("cols_",k)))[i]) for k = 1:NF]...))
+    x
+end
+
+soa_setindex_body(NF::Int) = quote
+    @inbounds begin
+        $([:($(symbol(string("cols_",k)))[i] = getfield(x, $k)) for k = 1:NF]...)
+    end
+    nothing
+end
+
+eval(ngenerate(:NF, :T, :(soa_getindex{T}(t::Type{T}, i::Int, cols::NTuple{NF,AbstractArray}...)),
+               soa_getindex_body, 1:8))
+eval(ngenerate(:NF, :Nothing, :(soa_setindex!(x, i::Int, cols::NTuple{NF,AbstractArray}...)),
+               soa_setindex_body, 1:8))
@@ -124,6 +124,7 @@ include("float16.jl")
 include("cartesian.jl")
 using .Cartesian
 include("multidimensional.jl")
+include("structofarrays.jl")
 
 include("primes.jl")
 
@@ -136,6 +137,7 @@ include("poll.jl")
 
 # code loading
 include("loading.jl")
+include("inferencecache.jl")
 
 begin
     SOURCE_PATH = ""
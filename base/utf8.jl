@@ -37,7 +37,7 @@ function endof(s::UTF8String)
     end
     i
 end
-length(s::UTF8String) = int(ccall(:u8_strlen, Csize_t, (Ptr{Uint8},), s.data))
+length(s::UTF8String) = int(ccall(:u8_charcount, Csize_t, (Ptr{Uint8}, Csize_t), s.data, length(s.data)))
 
 function getindex(s::UTF8String, i::Int)
     # potentially faster version
@@ -12,6 +12,14 @@ gc_time_ns() = ccall(:jl_gc_total_hrtime, Uint64, ())
 # total number of bytes allocated so far
 gc_bytes() = ccall(:jl_gc_total_bytes, Int64, ())
 
+# (hits, misses) of the memo of type queries, for subtype, invariant
+# subtype, specificity and intersection queries
+function typememo_counts()
+    c = Array(Csize_t, 8)
+    ccall(:jl_typememo_counts, Void, (Ptr{Csize_t},), c)
+    ntuple(4, i->(int(c[2i-1]), int(c[2i])))
+end
+
 function tic()
     t0 = time_ns()
     task_local_storage(:TIMERS, (t0, get(task_local_storage(), :TIMERS, ())))
@@ -414,83 +414,139 @@ jl_lambda_info_t *jl_new_lambda_info(jl_value_t *ast, jl_tuple_t *sparams)
 
 // symbols --------------------------------------------------------------------
 
-static jl_sym_t *symtab = NULL;
+// Symbols are interned in an open-addressed hash table of pointers, with
+// linear probing, kept at most half full. They are never freed, so they are
+// allocated sequentially from large malloc'd blocks.
+
+static jl_sym_t **symtab = NULL;
+static size_t symtab_size = 0;    // power of 2
+static size_t symtab_count = 0;
+
+#define SYM_BLOCK_SIZE (64*1024)
+static char *sym_block = NULL;
+static size_t sym_block_left = 0;
 
 static uptrint_t hash_symbol(const char *str, size_t len)
 {
     return memhash(str, len) ^ ~(uptrint_t)0/3*2;
 }
 
-static jl_sym_t *mk_symbol(const char *str)
+static void *sym_alloc(size_t sz)
+{
+    if (sz > SYM_BLOCK_SIZE/4)
+        return malloc(sz);
+    if (sz > sym_block_left) {
+        sym_block = (char*)malloc(SYM_BLOCK_SIZE);
+        if (sym_block == NULL)
+            jl_throw(jl_memory_exception);
+        sym_block_left = SYM_BLOCK_SIZE;
+    }
+    void *p = sym_block;
+    sym_block += sz;
+    sym_block_left -= sz;
+    return p;
+}
+
+static jl_sym_t *mk_symbol(const char *str, size_t len, uptrint_t h)
 {
     jl_sym_t *sym;
-    size_t len = strlen(str);
 
-    sym = (jl_sym_t*)malloc((sizeof(jl_sym_t)+len+1+7)&-8);
+    sym = (jl_sym_t*)sym_alloc((sizeof(jl_sym_t)+len+1+7)&-8);
     sym->type = (jl_value_t*)jl_sym_type;
-    sym->left = sym->right = NULL;
-    sym->hash = hash_symbol(str, len);
-    strcpy(&sym->name[0], str);
+    sym->hash = h;
+    memcpy(&sym->name[0], str, len);
+    sym->name[len] = '\0';
     return sym;
 }
 
-static void unmark_symbols_(jl_sym_t *root)
-{
-    while (root != NULL) {
-        root->type = (jl_value_t*)(((uptrint_t)root->type)&~1UL);
-        unmark_symbols_(root->left);
-        root = root->right;
+// returns the slot holding the symbol, or the empty slot where it belongs
+static jl_sym_t **symtab_lookup(const char *str, size_t len, uptrint_t h)
+{
+    size_t mask = symtab_size-1;
+    size_t i = h & mask;
+    while (symtab[i] != NULL) {
+        jl_sym_t *sym = symtab[i];
+        if (sym->hash == h && strncmp(str, sym->name, len) == 0 &&
+            sym->name[len] == '\0')
+            return &symtab[i];
+        i = (i+1) & mask;
+    }
+    return &symtab[i];
+}
+
+static void symtab_grow(void)
+{
+    jl_sym_t **old = symtab;
+    size_t oldsz = symtab_size;
+    symtab_size = oldsz ? oldsz*2 : 4096;
+    symtab = (jl_sym_t**)calloc(symtab_size, sizeof(jl_sym_t*));
+    if (symtab == NULL)
+        jl_throw(jl_memory_exception);
+    for(size_t i=0; i < oldsz; i++) {
+        jl_sym_t *sym = old[i];
+        if (sym != NULL) {
+            size_t j = sym->hash & (symtab_size-1);
+            while (symtab[j] != NULL)
+                j = (j+1) & (symtab_size-1);
+            symtab[j] = sym;
+        }
     }
+    free(old);
 }
 
-void jl_unmark_symbols(void) { unmark_symbols_(symtab); }
+// the GC marks symbols it reaches but never frees them
+void jl_unmark_symbols(void)
+{
+    for(size_t i=0; i < symtab_size; i++) {
+        jl_sym_t *sym = symtab[i];
+        if (sym != NULL)
+            sym->type = (jl_value_t*)(((uptrint_t)sym->type)&~1UL);
+    }
+}
 
-static jl_sym_t **symtab_lookup(jl_sym_t **ptree, const char *str)
+void jl_foreach_symbol(void (*f)(jl_sym_t*, void*), void *data)
 {
-    int x;
-    uptrint_t h = hash_symbol(str, strlen(str));
+    for(size_t i=0; i < symtab_size; i++) {
+        if (symtab[i] != NULL)
+            f(symtab[i], data);
+    }
+}
 
-    // Tree nodes sorted by major key of (int(hash)) and minor key o (str).
-    while(*ptree != NULL) {
-        x = (int)(h-(*ptree)->hash);
-        if (x == 0) {
-            x = strcmp(str, (*ptree)->name);
-            if (x == 0)
-                return ptree;
-        }
-        if (x < 0)
-            ptree = &(*ptree)->left;
-        else
-            ptree = &(*ptree)->right;
+static jl_sym_t *_jl_symbol(const char *str, size_t len)
+{
+    if (2*(symtab_count+1) > symtab_size)
+        symtab_grow();
+    uptrint_t h = hash_symbol(str, len);
+    jl_sym_t **slot = symtab_lookup(str, len, h);
+    if (*slot == NULL) {
+        *slot = mk_symbol(str, len, h);
+        symtab_count++;
     }
-    return ptree;
+    return *slot;
 }
 
 jl_sym_t *jl_symbol(const char *str)
 {
-    jl_sym_t **pnode;
-
-    pnode = symtab_lookup(&symtab, str);
-    if (*pnode == NULL)
-        *pnode = mk_symbol(str);
-    return *pnode;
+    return _jl_symbol(str, strlen(str));
 }
 
 jl_sym_t *jl_symbol_lookup(const char *str)
 {
-    return *symtab_lookup(&symtab, str);
+    if (symtab == NULL)
+        return NULL;
+    size_t len = strlen(str);
+    return *symtab_lookup(str, len, hash_symbol(str, len));
 }
 
 DLLEXPORT jl_sym_t *jl_symbol_n(const char *str, int32_t len)
 {
-    char *name = (char*)alloca(len+1);
-    memcpy(name, str, len);
-    name[len] = '\0';
-    return jl_symbol(name);
+    // like jl_symbol, the name ends at the first \0
+    const char *nul = (const char*)memchr(str, 0, len);
+    if (nul != NULL)
+        len = nul - str;
+    return _jl_symbol(str, len);
 }
 
-DLLEXPORT jl_sym_t *jl_get_root_symbol() { return symtab; }
-
 static uint32_t gs_ctr = 0;  // TODO: per-thread
 uint32_t jl_get_gs_ctr(void) { return gs_ctr; }
 void jl_set_gs_ctr(uint32_t ctr) { gs_ctr = ctr; }
@@ -522,11 +578,12 @@ DLLEXPORT jl_sym_t *jl_tagged_gensym(const char* str, int32_t len)
 
 jl_typename_t *jl_new_typename(jl_sym_t *name)
 {
-    jl_typename_t *tn=(jl_typename_t*)newobj((jl_value_t*)jl_typename_type, 4);
+    jl_typename_t *tn=(jl_typename_t*)newobj((jl_value_t*)jl_typename_type, 5);
     tn->name = name;
     tn->module = jl_current_module;
     tn->primary = NULL;
     tn->cache = (jl_value_t*)jl_null;
+    tn->linearcache = (jl_value_t*)jl_null;
     return tn;
 }
 
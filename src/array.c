@@ -16,12 +16,24 @@ extern "C" {
 
 // array constructors ---------------------------------------------------------
 
+// leaf immutables are stored inline unless all of their fields are references,
+// in which case a boxed element costs only one extra word
 static inline int store_unboxed(jl_value_t *el_type)
 {
-    return jl_is_datatype(el_type) && jl_is_leaf_type(el_type) && jl_is_immutable(el_type) && jl_is_pointerfree((jl_datatype_t*)el_type);
+    if (!(jl_is_datatype(el_type) && jl_is_leaf_type(el_type) && jl_is_immutable(el_type)))
+        return 0;
+    jl_datatype_t *dt = (jl_datatype_t*)el_type;
+    if (dt->pointerfree)
+        return 1;
+    size_t i, nf = jl_tuple_len(dt->names);
+    for(i=0; i < nf; i++) {
+        if (!dt->fields[i].isptr)
+            return 1;
+    }
+    return 0;
 }
 
-int jl_array_store_unboxed(jl_value_t *el_type)
+DLLEXPORT int jl_array_store_unboxed(jl_value_t *el_type)
 {
     return store_unboxed(el_type);
 }
@@ -43,6 +55,8 @@ static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
     wideint_t prod;
     void *data;
     jl_array_t *a;
+    // inline elements with references start out unassigned
+    int zeroinit = !isunboxed || !jl_is_pointerfree(jl_tparam0(atype));
 
     for(i=0; i < ndims; i++) {
         prod = (wideint_t)nel * (wideint_t)dims[i];
@@ -81,7 +95,7 @@ static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
         a->type = atype;
         a->how = 0;
         data = (char*)a + doffs;
-        if (tot > 0 && !isunboxed) {
+        if (tot > 0 && zeroinit) {
             memset(data, 0, tot);
         }
     }
@@ -95,7 +109,7 @@ static jl_array_t *_new_array_(jl_value_t *atype, uint32_t ndims, size_t *dims,
         a->how = 2;
         data = jl_gc_managed_malloc(tot);
         jl_gc_track_malloced_array(a);
-        if (!isunboxed)
+        if (zeroinit)
             memset(data, 0, tot);
         JL_GC_POP();
     }
@@ -416,7 +430,16 @@ jl_value_t *jl_arrayref(jl_array_t *a, size_t i)
     jl_value_t *el_type = (jl_value_t*)jl_tparam0(jl_typeof(a));
     jl_value_t *elt;
     if (!a->ptrarray) {
-        elt = jl_new_bits(el_type, &((char*)a->data)[i*a->elsize]);
+        char *data = &((char*)a->data)[i*a->elsize];
+        if (!jl_is_pointerfree(el_type)) {
+            if (*(jl_value_t**)(data + jl_first_ptr_field((jl_datatype_t*)el_type)) == NULL)
+                jl_throw(jl_undefref_exception);
+            elt = newstruct((jl_datatype_t*)el_type);
+            memcpy(jl_data_ptr(elt), data, a->elsize);
+        }
+        else {
+            elt = jl_new_bits(el_type, data);
+        }
     }
     else {
         elt = ((jl_value_t**)a->data)[i];
@@ -485,6 +508,11 @@ int jl_array_isdefined(jl_value_t **args0, int nargs)
 
     if (a->ptrarray)
         return ((jl_value_t**)jl_array_data(a))[i] != NULL;
+    if (jl_array_hasptrs(a)) {
+        jl_datatype_t *el_type = (jl_datatype_t*)jl_tparam0(jl_typeof(a));
+        char *data = (char*)jl_array_data(a) + i*a->elsize;
+        return *(jl_value_t**)(data + jl_first_ptr_field(el_type)) != NULL;
+    }
     return 1;
 }
 
@@ -518,7 +546,7 @@ void jl_arrayunset(jl_array_t *a, size_t i)
     if (i >= jl_array_len(a))
         jl_throw(jl_bounds_exception);
     char *ptail = (char*)a->data + i*a->elsize;
-    if (a->ptrarray)
+    if (a->ptrarray || jl_array_hasptrs(a))
         memset(ptail, 0, a->elsize);
 }
 
@@ -567,7 +595,7 @@ static void array_resize_buffer(jl_array_t *a, size_t newlen, size_t oldlen, siz
 
     a->data = newdata + offsnb;
     a->isshared = 0;
-    if (a->ptrarray || es==1)
+    if (a->ptrarray || es==1 || jl_array_hasptrs(a))
         memset(newdata+offsnb+oldnbytes, 0, nbytes-oldnbytes-offsnb);
     a->maxsize = newlen;
 }
@@ -622,7 +650,7 @@ void jl_array_del_end(jl_array_t *a, size_t dec)
     if (a->elsize > 0) {
         char *ptail = (char*)a->data + (a->nrows-dec)*a->elsize;
         assert(ptail < (char*)a->data + (a->length*a->elsize));
-        if (a->ptrarray)
+        if (a->ptrarray || jl_array_hasptrs(a))
             memset(ptail, 0, dec*a->elsize);
         else
             ptail[0] = 0;
@@ -668,7 +696,7 @@ void jl_array_grow_beg(jl_array_t *a, size_t inc)
             size_t center = (newlen - (alen + inc))/2;
             array_resize_buffer(a, newlen, alen, center+inc);
             char *newdata = (char*)a->data - (center+inc)*es;
-            if (a->ptrarray) {
+            if (a->ptrarray || jl_array_hasptrs(a)) {
                 memset(newdata, 0, (center+inc)*es);
             }
             a->offset = center;
@@ -34,6 +34,7 @@ static value_t true_sym;
 static value_t false_sym;
 static value_t fl_error_sym;
 static value_t fl_null_sym;
+static value_t parsed_form_sym;
 
 static jl_value_t *scm_to_julia(value_t e, int expronly);
 static value_t julia_to_scm(jl_value_t *v);
@@ -136,6 +137,8 @@ DLLEXPORT void jl_init_frontend(void)
     false_sym = symbol("false");
     fl_error_sym = symbol("error");
     fl_null_sym = symbol("null");
+    parsed_form_sym = symbol("*jl-parsed-form*");
+    symbol_value(parsed_form_sym) = FL_NIL;
 }
 
 DLLEXPORT void jl_lisp_prompt(void)
@@ -491,6 +494,175 @@ DLLEXPORT jl_value_t *jl_parse_string(const char *str, int pos0, int greedy)
     return result;
 }
 
+// The form most recently read by jl_parse_next is kept in its flisp form as
+// well (as the value of *jl-parsed-form*), so that expanding it can hand the
+// parser's own tree back to the front end instead of converting the Julia
+// AST into a fresh one. For module and toplevel forms the candidates are
+// the forms in the body, which are expanded one at a time in order.
+// Candidates are matched by identity, so both are GC roots (see gc_mark):
+// a collected form's address could otherwise be reused by an unrelated one.
+jl_value_t *jl_parsed_form = NULL;
+jl_array_t *jl_parsed_body = NULL;
+static size_t parsed_next = 0;
+
+// Expansion of body forms may skip a few (line numbers, using, export ...),
+// so the next few forms are candidates. This relies on the body being a
+// positional conversion of the flisp list, one argument per element, which
+// holds for anything scm_to_julia produced. It would be unsafe for a body
+// that was edited after parsing (forms inserted or removed, e.g. by code
+// holding a reference to the module Expr): positions would then pair a form
+// with another form's tree. share_parsed_ only catches such a pairing when
+// the two trees differ in shape, so the state is cleared whenever a parse
+// ends, fails, or an expansion throws.
+#define PARSED_LOOKAHEAD 16
+
+static void clear_parsed_form(void)
+{
+    jl_parsed_form = NULL;
+    jl_parsed_body = NULL;
+    parsed_next = 0;
+    symbol_value(parsed_form_sym) = FL_NIL;
+}
+
+static void set_parsed_form(value_t e, jl_value_t *v)
+{
+    clear_parsed_form();
+    if (!iscons(e) || !jl_is_expr(v))
+        return;
+    jl_expr_t *ex = (jl_expr_t*)v;
+    if (ex->head == module_sym) {
+        if (jl_array_len(ex->args) == 3 && jl_is_expr(jl_exprarg(ex,2)) &&
+            llength(e) == 4 && iscons(car_(cdr_(cdr_(cdr_(e)))))) {
+            jl_parsed_body = ((jl_expr_t*)jl_exprarg(ex,2))->args;
+            symbol_value(parsed_form_sym) = cdr_(car_(cdr_(cdr_(cdr_(e)))));
+        }
+    }
+    else if (ex->head == toplevel_sym) {
+        jl_parsed_body = ex->args;
+        symbol_value(parsed_form_sym) = cdr_(e);
+    }
+    else {
+        jl_parsed_form = v;
+        symbol_value(parsed_form_sym) = e;
+    }
+}
+
+static int same_scm_symbol(value_t s, jl_value_t *v)
+{
+    return jl_is_symbol(v) && !fl_isgensym(s) &&
+        strcmp(symbol_name(s), ((jl_sym_t*)v)->name) == 0;
+}
+
+// whether julia_to_scm(v) would give back leaf e itself
+static int same_scm_leaf(value_t e, jl_value_t *v)
+{
+    if (issymbol(e))
+        return same_scm_symbol(e, v);
+    if (e == FL_T)
+        return v == jl_true;
+    if (e == FL_F)
+        return v == jl_false;
+    if (isfixnum(e))
+        return jl_is_long(v) && jl_unbox_long(v) == numval(e);
+    return 0;
+}
+
+static jl_sym_t *node_head(jl_value_t *v)
+{
+    if (jl_typeis(v, jl_linenumbernode_type)) return line_sym;
+    if (jl_typeis(v, jl_labelnode_type)) return label_sym;
+    if (jl_typeis(v, jl_gotonode_type)) return goto_sym;
+    if (jl_typeis(v, jl_quotenode_type)) return quote_sym;
+    if (jl_typeis(v, jl_newvarnode_type)) return newvar_sym;
+    if (jl_typeis(v, jl_topnode_type)) return top_sym;
+    return NULL;
+}
+
+// Make parsed tree e equal to julia_to_scm(v), where v was converted from e.
+// Only leaves that do not survive the round trip unchanged (strings,
+// non-fixnum numbers, chars, true and false) are replaced. Returns 0 if the
+// trees do not correspond.
+static int share_parsed_(value_t e, jl_value_t *v)
+{
+    jl_value_t **args;
+    jl_value_t *field;
+    jl_sym_t *head;
+    size_t n;
+    if (jl_is_expr(v)) {
+        head = ((jl_expr_t*)v)->head;
+        args = &jl_cellref(((jl_expr_t*)v)->args,0);
+        n = jl_array_len(((jl_expr_t*)v)->args);
+    }
+    else if (v == jl_nothing) {
+        return car_(e) == fl_null_sym && cdr_(e) == FL_NIL;
+    }
+    else if ((head = node_head(v)) != NULL) {
+        field = jl_fieldref(v,0);
+        args = &field;
+        n = 1;
+    }
+    else {
+        return 0;
+    }
+    if (!issymbol(car_(e)) || !same_scm_symbol(car_(e), (jl_value_t*)head))
+        return 0;
+    value_t l = cdr_(e);
+    fl_gc_handle(&l);
+    size_t i;
+    int ok = 1;
+    for(i=0; ok && i < n && iscons(l); i++) {
+        value_t a = car_(l);
+        if (iscons(a)) {
+            ok = share_parsed_(a, args[i]);
+        }
+        else if (!same_scm_leaf(a, args[i])) {
+            value_t temp = julia_to_scm_(args[i]);
+            // note: must be separate statement
+            car_(l) = temp;
+        }
+        l = cdr_(l);
+    }
+    ok = ok && i == n && l == FL_NIL;
+    fl_free_gc_handles(1);
+    return ok;
+}
+
+// the parser's tree for expr if it is the next form read from the file
+// being loaded, or #f
+static value_t reuse_parsed_form(jl_value_t *expr)
+{
+    value_t e = FL_F;
+    if (jl_parsed_form != NULL && expr == jl_parsed_form) {
+        e = symbol_value(parsed_form_sym);
+        clear_parsed_form();
+    }
+    else if (jl_parsed_body != NULL) {
+        value_t l = symbol_value(parsed_form_sym);
+        size_t n = jl_array_len(jl_parsed_body), i;
+        for(i=parsed_next; i < n && i < parsed_next+PARSED_LOOKAHEAD && iscons(l);
+            i++, l = cdr_(l)) {
+            if (jl_cellref(jl_parsed_body,i) == expr) {
+                e = car_(l);
+                parsed_next = i+1;
+                symbol_value(parsed_form_sym) = cdr_(l);
+                break;
+            }
+        }
+    }
+    if (!iscons(e))
+        return FL_F;
+    int ok = 0;
+    fl_gc_handle(&e);
+    FL_TRY_EXTERN {
+        ok = share_parsed_(e, expr);
+    }
+    FL_CATCH_EXTERN {
+        ok = 0;
+    }
+    fl_free_gc_handles(1);
+    return ok ? e : FL_F;
+}
+
 int jl_start_parsing_file(const char *fname)
 {
     value_t s = cvalue_static_cstring(fname);
@@ -501,6 +673,7 @@ int jl_start_parsing_file(const char *fname)
 
 void jl_stop_parsing(void)
 {
+    clear_parsed_form();
     fl_applyn(0, symbol_value(symbol("jl-parser-close-stream")));
 }
 
@@ -524,7 +697,12 @@ jl_value_t *jl_parse_next(void)
     // for error, get most recent line number
     if (iscons(c) && car_(c) == fl_error_sym)
         jl_lineno = numval(fl_applyn(0, symbol_value(symbol("jl-parser-current-lineno"))));
-    return scm_to_julia(c,0);
+    clear_parsed_form();
+    fl_gc_handle(&c);
+    jl_value_t *v = scm_to_julia(c,0);
+    set_parsed_form(c, v);
+    fl_free_gc_handles(1);
+    return v;
 }
 
 jl_value_t *jl_load_file_string(const char *text, char *filename)
@@ -543,9 +721,18 @@ jl_value_t *jl_load_file_string(const char *text, char *filename)
 jl_value_t *jl_expand(jl_value_t *expr)
 {
     int np = jl_gc_n_preserved_values();
-    value_t arg = julia_to_scm(expr);
-    value_t e = fl_applyn(1, symbol_value(symbol("jl-expand-to-thunk")), arg);
-    jl_value_t *result = scm_to_julia(e,0);
+    jl_value_t *result = NULL;
+    JL_TRY {
+        value_t arg = reuse_parsed_form(expr);
+        if (arg == FL_F)
+            arg = julia_to_scm(expr);
+        value_t e = fl_applyn(1, symbol_value(symbol("jl-expand-to-thunk")), arg);
+        result = scm_to_julia(e,0);
+    }
+    JL_CATCH {
+        clear_parsed_form();
+        jl_rethrow();
+    }
     while (jl_gc_n_preserved_values() > np) {
         jl_gc_unpreserve();
     }
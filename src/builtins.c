@@ -602,26 +602,39 @@ DLLEXPORT void jl_print_int64(JL_STREAM *s, int64_t i)
     JL_PRINTF(s, "%lld", i);
 }
 
+// The substring parsers first parse in place. Only when the number ran on
+// past the end of the substring does it have to be copied out and parsed
+// again; short copies stay on the stack.
+#define SUBSTR_BUFSIZE 64
+
+static char *substr_copy(char *bstr, int len, char *buf)
+{
+    char *newstr = (len < SUBSTR_BUFSIZE) ? buf : (char*)malloc(len+1);
+    memcpy(newstr, bstr, len);
+    newstr[len] = 0;
+    return newstr;
+}
+
 DLLEXPORT int jl_substrtod(char *str, size_t offset, int len, double *out)
 {
     char *p;
-    errno = 0;
+    char buf[SUBSTR_BUFSIZE];
     char *bstr = str+offset;
     char *pend = bstr+len;
     int err = 0;
-    if (!(*pend == '\0' || isspace(*pend) || *pend == ',')) {
-        // confusing data outside substring. must copy.
-        char *newstr = malloc(len+1);
-        memcpy(newstr, bstr, len);
-        newstr[len] = 0;
-        bstr = newstr;
+    errno = 0;
+    *out = strtod_c(bstr, &p);
+    if (p > pend) {
+        // the data after the substring continues the number. must copy.
+        bstr = substr_copy(bstr, len, buf);
         pend = bstr+len;
+        errno = 0;
+        *out = strtod_c(bstr, &p);
     }
-    *out = strtod_c(bstr, &p);
     if ((p == bstr) || (p != pend) ||
         (errno==ERANGE && (*out==0 || *out==HUGE_VAL || *out==-HUGE_VAL)))
         err = 1;
-    if (bstr != str+offset)
+    if (bstr != str+offset && bstr != buf)
         free(bstr);
     return err;
 }
@@ -650,28 +663,32 @@ DLLEXPORT int jl_strtod(char *str, double *out)
 DLLEXPORT int jl_substrtof(char *str, int offset, int len, float *out)
 {
     char *p;
-    errno = 0;
+    char buf[SUBSTR_BUFSIZE];
     char *bstr = str+offset;
     char *pend = bstr+len;
     int err = 0;
-    if (!(*pend == '\0' || isspace(*pend) || *pend == ',')) {
-        // confusing data outside substring. must copy.
-        char *newstr = malloc(len+1);
-        memcpy(newstr, bstr, len);
-        newstr[len] = 0;
-        bstr = newstr;
-        pend = bstr+len;
-    }
+    errno = 0;
 #if defined(_OS_WINDOWS_) && !defined(_COMPILER_MINGW_)
     *out = (float)strtod_c(bstr, &p);
 #else
     *out = strtof_c(bstr, &p);
 #endif
+    if (p > pend) {
+        // the data after the substring continues the number. must copy.
+        bstr = substr_copy(bstr, len, buf);
+        pend = bstr+len;
+        errno = 0;
+#if defined(_OS_WINDOWS_) && !defined(_COMPILER_MINGW_)
+        *out = (float)strtod_c(bstr, &p);
+#else
+        *out = strtof_c(bstr, &p);
+#endif
+    }
 
     if ((p == bstr) || (p != pend) ||
         (errno==ERANGE && (*out==0 || *out==HUGE_VALF || *out==-HUGE_VALF)))
         err = 1;
-    if (bstr != str+offset)
+    if (bstr != str+offset && bstr != buf)
         free(bstr);
     return err;
 }
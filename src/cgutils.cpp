@@ -899,6 +899,45 @@ static Value *typed_store(Value *ptr, Value *idx_0based, Value *rhs,
     return tbaa_decorate(tbaa_user, builder.CreateStore(rhs, builder.CreateGEP(data, idx_0based)));
 }
 
+// immutables with reference fields are stored inline in arrays but are
+// always boxed in generated code, so elements are copied into and out of boxes
+
+static Value *inline_elt_ptr(Value *ptr, Value *idx_0based, jl_datatype_t *dt)
+{
+    Value *offs = builder.CreateMul(idx_0based, ConstantInt::get(T_size, dt->size));
+    return builder.CreateGEP(builder.CreateBitCast(ptr, T_pint8), offs);
+}
+
+static Value *inline_load(Value *ptr, Value *idx_0based, jl_value_t *jltype,
+                          jl_codectx_t *ctx)
+{
+    jl_datatype_t *dt = (jl_datatype_t*)jltype;
+    uint64_t size = dt->size;
+    Value *elt = inline_elt_ptr(ptr, idx_0based, dt);
+    // unassigned elements have a NULL first reference field
+    Value *fld = builder.CreateGEP(elt, ConstantInt::get(T_size, jl_first_ptr_field(dt)));
+    null_pointer_check(tbaa_decorate(tbaa_user, builder.CreateLoad(
+                           builder.CreateBitCast(fld, jl_ppvalue_llvmt), false)), ctx);
+    Value *strct =
+        builder.CreateCall(prepare_call(jlallocobj_func),
+                           ConstantInt::get(T_size, sizeof(void*)+size));
+    builder.CreateStore(literal_pointer_val(jltype),
+                        emit_nthptr_addr(strct, (size_t)0));
+    builder.CreateMemCpy(builder.CreateBitCast(emit_nthptr_addr(strct, (size_t)1), T_pint8),
+                         elt, size, 1);
+    return mark_julia_type(strct, jltype);
+}
+
+static void inline_store(Value *ptr, Value *idx_0based, Value *rhs,
+                         jl_value_t *jltype, jl_codectx_t *ctx)
+{
+    jl_datatype_t *dt = (jl_datatype_t*)jltype;
+    rhs = boxed(rhs,ctx);
+    builder.CreateMemCpy(inline_elt_ptr(ptr, idx_0based, dt),
+                         builder.CreateBitCast(emit_nthptr_addr(rhs, (size_t)1), T_pint8),
+                         dt->size, 1);
+}
+
 // --- convert boolean value to julia ---
 
 static Value *julia_bool(Value *cond)
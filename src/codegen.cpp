@@ -1942,6 +1942,8 @@ static Value *emit_known_call(jl_value_t *ff, jl_value_t **args, size_t nargs,
                         assert(jl_is_datatype(ety));
                         return literal_pointer_val(((jl_datatype_t*)ety)->instance);
                     }
+                    if (jl_array_store_unboxed(ety) && !jl_is_pointerfree(ety))
+                        return inline_load(emit_arrayptr(ary, args[1], ctx), idx, ety, ctx);
                     return typed_load(emit_arrayptr(ary, args[1], ctx), idx, ety, ctx);
                 }
             }
@@ -1972,6 +1974,10 @@ static Value *emit_known_call(jl_value_t *ff, jl_value_t **args, size_t nargs,
                         assert(jl_is_datatype(ety));
                         emit_expr(args[2],ctx,false);
                     }
+                    else if (jl_array_store_unboxed(ety) && !jl_is_pointerfree(ety)) {
+                        inline_store(emit_arrayptr(ary,args[1],ctx), idx,
+                                     emit_expr(args[2],ctx), ety, ctx);
+                    }
                     else {
                         typed_store(emit_arrayptr(ary,args[1],ctx), idx,
                                     ety==(jl_value_t*)jl_any_type ? emit_expr(args[2],ctx) : emit_unboxed(args[2],ctx),
@@ -10,6 +10,12 @@
 #include "julia.h"
 #include "julia_internal.h"
 #include "builtin_proto.h"
+#ifndef _OS_WINDOWS_
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +49,9 @@ static jl_value_t *jl_idtable_type=NULL;
 // queue of types to cache
 static jl_array_t *datatype_list=NULL;
 
+// the system image stream, while it is being restored from a memory mapping
+static ios_t *mapped_sysimg=NULL;
+
 #define write_uint8(s, n) ios_putc((n), (s))
 #define read_uint8(s) ((uint8_t)ios_getc(s))
 #define write_int8(s, n) write_uint8(s, n)
@@ -183,8 +192,9 @@ static void jl_deserialize_globalvals(ios_t *s)
     }
 }
 
-static void jl_serialize_gv_syms(ios_t *s, jl_sym_t *v)
+static void jl_serialize_gv_sym(jl_sym_t *v, void *data)
 {
+    ios_t *s = (ios_t*)data;
     // ensures all symbols referenced in the code have
     // references in the system image to their global variable
     // since symbols are static, they might not have had a
@@ -197,8 +207,6 @@ static void jl_serialize_gv_syms(ios_t *s, jl_sym_t *v)
             write_int32(s, gv);
         }
     }
-    if (v->left) jl_serialize_gv_syms(s, v->left);
-    if (v->right) jl_serialize_gv_syms(s, v->right);
 }
 
 static void jl_deserialize_gv_syms(ios_t *s)
@@ -457,7 +465,21 @@ static void jl_serialize_value_(ios_t *s, jl_value_t *v)
         jl_serialize_value(s, jl_typeof(ar));
         for (i=0; i < ar->ndims; i++)
             jl_serialize_value(s, jl_box_long(jl_array_dim(ar,i)));
-        if (!ar->ptrarray) {
+        if (jl_array_hasptrs(ar)) {
+            jl_datatype_t *et = (jl_datatype_t*)jl_tparam0(jl_typeof(ar));
+            size_t j, nf = jl_tuple_len(et->names);
+            for(i=0; i < jl_array_len(ar); i++) {
+                char *data = (char*)jl_array_data(ar) + i*ar->elsize;
+                for(j=0; j < nf; j++) {
+                    char *fld = data + et->fields[j].offset;
+                    if (et->fields[j].isptr)
+                        jl_serialize_value(s, *(jl_value_t**)fld);
+                    else
+                        ios_write(s, fld, et->fields[j].size);
+                }
+            }
+        }
+        else if (!ar->ptrarray) {
             size_t tot = jl_array_len(ar) * ar->elsize;
             ios_write(s, (char*)jl_array_data(ar), tot);
         }
@@ -509,7 +531,18 @@ static void jl_serialize_value_(ios_t *s, jl_value_t *v)
     else if (jl_is_lambda_info(v)) {
         writetag(s, jl_lambda_info_type);
         jl_lambda_info_t *li = (jl_lambda_info_t*)v;
-        jl_serialize_value(s, li->ast);
+        if (jl_typeis(li->ast, jl_array_uint8_type)) {
+            // compressed AST: stored inline, so that a mapped image can
+            // refer to it in place
+            size_t len = jl_array_len(li->ast);
+            write_int8(s, 1);
+            write_int32(s, len);
+            ios_write(s, (char*)jl_array_data(li->ast), len);
+        }
+        else {
+            write_int8(s, 0);
+            jl_serialize_value(s, li->ast);
+        }
         jl_serialize_value(s, (jl_value_t*)li->sparams);
         // don't save cached type info for code in the Core module, because
         // it might reference types in the old Base module.
@@ -674,6 +707,26 @@ static jl_value_t *jl_deserialize_datatype(ios_t *s, int pos)
 
 jl_array_t *jl_eqtable_put(jl_array_t *h, void *key, void *val);
 
+// read the bytes of a compressed AST. in a mapped system image the array
+// points into the mapping, so an AST is only paged in from disk when its
+// method is first inferred or compiled. such an array does not own its data
+// and is read-only (the mapping is PROT_READ): the mapping is never
+// unmapped, and compressed ASTs are never modified in place, only replaced
+// by new arrays when a method is re-inferred.
+static jl_value_t *jl_deserialize_compressed_ast(ios_t *s, size_t len)
+{
+    jl_array_t *a;
+    if (s == mapped_sysimg) {
+        a = jl_ptr_to_array_1d(jl_array_uint8_type, s->buf + s->bpos, len, 0);
+        ios_skip(s, len);
+    }
+    else {
+        a = jl_alloc_array_1d(jl_array_uint8_type, len);
+        ios_readall(s, (char*)jl_array_data(a), len);
+    }
+    return (jl_value_t*)a;
+}
+
 // Internal jl_deserialize_value. May return the placeholder value DTINSTANCE_PLACEHOLDER, unlike jl_deserialize_value
 static jl_value_t *jl_deserialize_value_internal(ios_t *s)
 {
@@ -758,7 +811,21 @@ static jl_value_t *jl_deserialize_value_internal(ios_t *s)
         jl_array_t *a = jl_new_array_for_deserialization((jl_value_t*)aty, ndims, dims, isunboxed, elsize);
         if (usetable)
             ptrhash_put(&backref_table, (void*)(ptrint_t)pos, (jl_value_t*)a);
-        if (!a->ptrarray) {
+        if (jl_array_hasptrs(a)) {
+            jl_datatype_t *et = (jl_datatype_t*)jl_tparam0(aty);
+            size_t j, nf = jl_tuple_len(et->names);
+            for(i=0; i < jl_array_len(a); i++) {
+                char *data = (char*)jl_array_data(a) + i*a->elsize;
+                for(j=0; j < nf; j++) {
+                    char *fld = data + et->fields[j].offset;
+                    if (et->fields[j].isptr)
+                        *(jl_value_t**)fld = jl_deserialize_value(s);
+                    else
+                        ios_read(s, fld, et->fields[j].size);
+                }
+            }
+        }
+        else if (!a->ptrarray) {
             size_t tot = jl_array_len(a) * a->elsize;
             ios_read(s, (char*)jl_array_data(a), tot);
         }
@@ -811,7 +878,13 @@ static jl_value_t *jl_deserialize_value_internal(ios_t *s)
                                       LAMBDA_INFO_NW);
         if (usetable)
             ptrhash_put(&backref_table, (void*)(ptrint_t)pos, li);
-        li->ast = jl_deserialize_value(s);
+        if (read_int8(s)) {
+            size_t len = read_int32(s);
+            li->ast = jl_deserialize_compressed_ast(s, len);
+        }
+        else {
+            li->ast = jl_deserialize_value(s);
+        }
         li->sparams = (jl_tuple_t*)jl_deserialize_value(s);
         li->tfunc = jl_deserialize_value(s);
         li->name = (jl_sym_t*)jl_deserialize_value(s);
@@ -1005,7 +1078,7 @@ void jl_save_system_image(char *fname)
         i += 1;
     }
     jl_serialize_globalvals(&f);
-    jl_serialize_gv_syms(&f, jl_get_root_symbol()); // serialize symbols with GlobalValue references
+    jl_foreach_symbol(jl_serialize_gv_sym, &f); // serialize symbols with GlobalValue references
     jl_serialize_value(&f, NULL); // signal the end of the symbols list
 
     // save module initialization order
@@ -1027,6 +1100,34 @@ void jl_save_system_image(char *fname)
     if (en) jl_gc_enable();
 }
 
+// map the whole image file read-only, so it can be deserialized straight
+// out of the page cache instead of through buffered read() calls.
+// returns NULL if the file cannot be mapped.
+static char *jl_map_sysimg(const char *fname, size_t *len)
+{
+#ifndef _OS_WINDOWS_
+    int fd = open(fname, O_RDONLY);
+    if (fd == -1)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return NULL;
+#ifdef MADV_WILLNEED
+    madvise(data, st.st_size, MADV_WILLNEED);
+#endif
+    *len = st.st_size;
+    return (char*)data;
+#else
+    return NULL;
+#endif
+}
+
 extern jl_function_t *jl_typeinf_func;
 extern int jl_boot_file_loaded;
 extern void jl_get_builtin_hooks(void);
@@ -1038,7 +1139,13 @@ void jl_restore_system_image(char *fname)
 {
     ios_t f;
     char *fpath = fname;
-    if (ios_file(&f, fpath, 1, 0, 0, 0) == NULL) {
+    size_t maplen = 0;
+    char *mapped = jl_map_sysimg(fpath, &maplen);
+    if (mapped != NULL) {
+        ios_static_buffer(&f, mapped, maplen);
+        mapped_sysimg = &f;
+    }
+    else if (ios_file(&f, fpath, 1, 0, 0, 0) == NULL) {
         JL_PRINTF(JL_STDERR, "System image file \"%s\" not found\n", fname);
         exit(1);
     }
@@ -1106,6 +1213,9 @@ void jl_restore_system_image(char *fname)
     jl_set_gs_ctr(read_int32(&f));
     htable_reset(&backref_table, 0);
 
+    // the mapping stays in place for the life of the process, since the
+    // compressed ASTs of restored methods point into it
+    mapped_sysimg = NULL;
     ios_close(&f);
     if (fpath != fname) free(fpath);
 
@@ -178,6 +178,7 @@ value_t fl_accum_julia_symbol(value_t *args, u_int32_t nargs)
         type_error("accum-julia-symbol", "wchar", args[0]);
     uint32_t wc = *(uint32_t*)cp_data((cprim_t*)ptr(args[0]));
     ios_t str;
+    int allascii = 1;
     ios_mem(&str, 0);
     while (jl_id_char(wc)) {
         ios_getutf8(s, &wc);
@@ -191,15 +192,53 @@ value_t fl_accum_julia_symbol(value_t *args, u_int32_t nargs)
             }
         }
         ios_pututf8(&str, wc);
+        allascii &= (wc < 0x80);
         if (ios_peekutf8(s, &wc) == IOS_EOF)
             break;
     }
     ios_pututf8(&str, 0);
-    return symbol(normalize(str.buf));
+    // ASCII identifiers are already in NFC
+    return symbol(allascii ? str.buf : normalize(str.buf));
+}
+
+// skip a comment starting at the # that was peeked: either #...<eol> or a
+// (possibly nested) #= ... =#. comments make up a good part of most source
+// files, so this avoids stepping through them a character at a time in the
+// interpreter.
+value_t fl_skipcomment(value_t *args, u_int32_t nargs)
+{
+    argcount("skip-comment", nargs, 1);
+    ios_t *s = fl_toiostream(args[0], "skip-comment");
+    int c = ios_getc(s);
+    assert(c == '#');
+    if (ios_peekc(s) != '=') {
+        while ((c = ios_peekc(s)) != IOS_EOF && c != '\n')
+            ios_getc(s);
+        return FL_T;
+    }
+    ios_getc(s);
+    size_t depth = 1;
+    while (depth > 0) {
+        c = ios_getc(s);
+        if (c == IOS_EOF) {
+            // NOTE: changing this may affect code in base/client.jl
+            lerror(symbol("error"), "incomplete: unterminated multi-line comment #= ... =#");
+        }
+        if (c == '=' && ios_peekc(s) == '#') {
+            ios_getc(s);
+            depth--;
+        }
+        else if (c == '#' && ios_peekc(s) == '=') {
+            ios_getc(s);
+            depth++;
+        }
+    }
+    return FL_T;
 }
 
 static builtinspec_t julia_flisp_func_info[] = {
     { "skip-ws", fl_skipws },
+    { "skip-comment", fl_skipcomment },
     { "accum-julia-symbol", fl_accum_julia_symbol },
     { "identifier-char?", fl_julia_identifier_char },
     { "identifier-start-char?", fl_julia_identifier_start_char },
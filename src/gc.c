@@ -255,6 +255,14 @@ static void sweep_weak_refs(void)
     weak_refs.len -= ndel;
 }
 
+// the type query memo holds its keys weakly too
+extern void jl_typememo_sweep(int (*alive)(jl_value_t*));
+
+static int gc_is_marked(jl_value_t *v)
+{
+    return gc_marked(v);
+}
+
 // finalization
 
 static htable_t finalizer_table;
@@ -740,6 +748,28 @@ static void push_root(jl_value_t *v, int d)
                 }
             }
         }
+        else if (a->data!=NULL && !((jl_datatype_t*)jl_tparam0(vt))->pointerfree) {
+            // immutables with reference fields, stored inline
+            jl_datatype_t *et = (jl_datatype_t*)jl_tparam0(vt);
+            size_t l = jl_array_len(a);
+            if (l > 100000 && d > MAX_MARK_DEPTH-10) {
+                goto queue_the_root;
+            }
+            else {
+                int nf = (int)jl_tuple_len(et->names);
+                char *data = (char*)a->data;
+                for(size_t i=0; i < l; i++) {
+                    for(int j=0; j < nf; j++) {
+                        if (et->fields[j].isptr) {
+                            jl_value_t *fld = *(jl_value_t**)(data + et->fields[j].offset);
+                            if (fld)
+                                gc_push_root(fld, d);
+                        }
+                    }
+                    data += a->elsize;
+                }
+            }
+        }
     }
     else if (vt == (jl_value_t*)jl_module_type) {
         gc_mark_module((jl_module_t*)v, d);
@@ -778,6 +808,8 @@ static void visit_mark_stack()
 }
 
 void jl_mark_box_caches(void);
+extern jl_value_t *jl_parsed_form;
+extern jl_array_t *jl_parsed_body;
 
 extern jl_value_t * volatile jl_task_arg_in_transit;
 #if defined(GCTIME) || defined(GC_FINAL_STATS)
@@ -813,6 +845,11 @@ static void gc_mark(void)
     gc_push_root(typeToTypeId, 0);
     if (jl_module_init_order != NULL)
         gc_push_root(jl_module_init_order, 0);
+    // forms whose parsed tree jl_expand may reuse
+    if (jl_parsed_form != NULL)
+        gc_push_root(jl_parsed_form, 0);
+    if (jl_parsed_body != NULL)
+        gc_push_root(jl_parsed_body, 0);
 
     // constants
     gc_push_root(jl_null, 0);
@@ -911,6 +948,7 @@ void jl_gc_collect(void)
         uint64_t t1 = jl_hrtime();
 #endif
         sweep_weak_refs();
+        jl_typememo_sweep(gc_is_marked);
         gc_sweep();
 #ifdef GCTIME
         JL_PRINTF(JL_STDERR, "sweep time %.3f ms\n", (jl_hrtime()-t1)*1.0e6);
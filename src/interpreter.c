@@ -457,17 +457,76 @@ static jl_value_t *eval(jl_value_t *e, jl_value_t **locals, size_t nl)
     return (jl_value_t*)jl_nothing;
 }
 
-static int label_idx(jl_value_t *tgt, jl_array_t *stmts)
+// Branch targets are resolved once per body rather than by scanning the
+// statements on every jump: targets[i] holds the index of the label that the
+// goto, gotoifnot or enter at statement i transfers control to.
+
+typedef struct {
+    long label;
+    int idx;
+} label_entry_t;
+
+static int label_entry_cmp(const void *a, const void *b)
+{
+    long la = ((label_entry_t*)a)->label, lb = ((label_entry_t*)b)->label;
+    return la < lb ? -1 : (la > lb ? 1 : 0);
+}
+
+static int label_lookup(label_entry_t *tab, size_t n, jl_value_t *tgt)
 {
-    size_t j;
     long ltgt = jl_unbox_long(tgt);
-    for(j=0; j < stmts->nrows; j++) {
-        jl_value_t *l = jl_cellref(stmts,j);
-        if (jl_is_labelnode(l) && jl_labelnode_label(l)==ltgt)
-            break;
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi-lo)/2;
+        if (tab[mid].label < ltgt)
+            lo = mid+1;
+        else
+            hi = mid;
     }
-    assert(j < stmts->nrows);
-    return j;
+    assert(lo < n && tab[lo].label == ltgt);
+    return tab[lo].idx;
+}
+
+static jl_value_t *jump_label(jl_value_t *stmt)
+{
+    if (jl_is_gotonode(stmt))
+        return jl_fieldref(stmt,0);
+    if (jl_is_expr(stmt)) {
+        jl_sym_t *head = ((jl_expr_t*)stmt)->head;
+        if (head == goto_ifnot_sym)
+            return jl_exprarg(stmt,1);
+        if (head == enter_sym)
+            return jl_exprarg(stmt,0);
+    }
+    return NULL;
+}
+
+static void resolve_labels(jl_array_t *stmts, int *targets)
+{
+    size_t n = jl_array_len(stmts), nlabels = 0, i;
+    for(i=0; i < n; i++) {
+        if (jl_is_labelnode(jl_cellref(stmts,i)))
+            nlabels++;
+    }
+    if (nlabels == 0)
+        return;
+    label_entry_t *tab = (label_entry_t*)malloc(nlabels*sizeof(label_entry_t));
+    size_t j = 0;
+    for(i=0; i < n; i++) {
+        jl_value_t *l = jl_cellref(stmts,i);
+        if (jl_is_labelnode(l)) {
+            tab[j].label = jl_labelnode_label(l);
+            tab[j].idx = i;
+            j++;
+        }
+    }
+    qsort(tab, nlabels, sizeof(label_entry_t), label_entry_cmp);
+    for(i=0; i < n; i++) {
+        jl_value_t *tgt = jump_label(jl_cellref(stmts,i));
+        if (tgt != NULL)
+            targets[i] = label_lookup(tab, nlabels, tgt);
+    }
+    free(tab);
 }
 
 jl_value_t *jl_toplevel_eval_body(jl_array_t *stmts)
@@ -475,8 +534,9 @@ jl_value_t *jl_toplevel_eval_body(jl_array_t *stmts)
     return eval_body(stmts, NULL, 0, 0, 1);
 }
 
-static jl_value_t *eval_body(jl_array_t *stmts, jl_value_t **locals, size_t nl,
-                             int start, int toplevel)
+static jl_value_t *eval_body_(jl_array_t *stmts, int *targets,
+                              jl_value_t **locals, size_t nl,
+                              int start, int toplevel)
 {
     jl_handler_t __eh;
     size_t i=start;
@@ -484,7 +544,7 @@ static jl_value_t *eval_body(jl_array_t *stmts, jl_value_t **locals, size_t nl,
     while (1) {
         jl_value_t *stmt = jl_cellref(stmts,i);
         if (jl_is_gotonode(stmt)) {
-            i = label_idx(jl_fieldref(stmt,0), stmts);
+            i = targets[i];
             continue;
         }
         if (jl_is_expr(stmt)) {
@@ -492,7 +552,7 @@ static jl_value_t *eval_body(jl_array_t *stmts, jl_value_t **locals, size_t nl,
             if (head == goto_ifnot_sym) {
                 jl_value_t *cond = eval(jl_exprarg(stmt,0), locals, nl);
                 if (cond == jl_false) {
-                    i = label_idx(jl_exprarg(stmt,1), stmts);
+                    i = targets[i];
                     continue;
                 }
                 else if (cond != jl_true) {
@@ -510,14 +570,14 @@ static jl_value_t *eval_body(jl_array_t *stmts, jl_value_t **locals, size_t nl,
             else if (head == enter_sym) {
                 jl_enter_handler(&__eh);
                 if (!jl_setjmp(__eh.eh_ctx,1)) {
-                    return eval_body(stmts, locals, nl, i+1, toplevel);
+                    return eval_body_(stmts, targets, locals, nl, i+1, toplevel);
                 }
                 else {
 #ifdef _OS_WINDOWS_
                     if (jl_exception_in_transit == jl_stackovf_exception)
                         _resetstkoflw();
 #endif
-                    i = label_idx(jl_exprarg(stmt,0), stmts);
+                    i = targets[i];
                     continue;
                 }
             }
@@ -544,6 +604,29 @@ static jl_value_t *eval_body(jl_array_t *stmts, jl_value_t **locals, size_t nl,
     return NULL;
 }
 
+// bodies up to this many statements keep their jump table on the C stack
+#define TARGETS_ON_STACK 512
+
+static jl_value_t *eval_body(jl_array_t *stmts, jl_value_t **locals, size_t nl,
+                             int start, int toplevel)
+{
+    size_t n = jl_array_len(stmts);
+    jl_array_t *buf = NULL;
+    int *targets;
+    if (n <= TARGETS_ON_STACK) {
+        targets = (int*)alloca(n*sizeof(int));
+    }
+    else {
+        buf = jl_alloc_array_1d(jl_array_uint8_type, n*sizeof(int));
+        targets = (int*)buf->data;
+    }
+    JL_GC_PUSH1(&buf);
+    resolve_labels(stmts, targets);
+    jl_value_t *r = eval_body_(stmts, targets, locals, nl, start, toplevel);
+    JL_GC_POP();
+    return r;
+}
+
 jl_value_t *jl_interpret_toplevel_thunk_with(jl_lambda_info_t *lam,
                                              jl_value_t **loc, size_t nl)
 {
@@ -1075,6 +1075,93 @@ static jl_value_t *jl_type_intersect(jl_value_t *a, jl_value_t *b,
     return result;
 }
 
+// memo of subtype, specificity and intersection queries --------------------
+
+// Top-level queries between DataTypes and unions without typevars are
+// remembered in a small direct-mapped table, keyed on the participating
+// pointers. These are immutable once complete; jl_typememo_clear drops
+// everything when a definition changes a supertype. Tuples are left out:
+// cache_method rewrites signature tuples in place, and they are mostly
+// freshly allocated anyway. Entries do not keep their types alive: the GC
+// drops entries mentioning dead objects, like weak references.
+
+#define TYPEMEMO_SIZE 4096
+
+enum { TYPEMEMO_SUBTYPE=1, TYPEMEMO_SUBTYPE_INV, TYPEMEMO_MORESPECIFIC,
+       TYPEMEMO_INTERSECT, TYPEMEMO_NKINDS };
+
+typedef struct {
+    jl_value_t *a;
+    jl_value_t *b;
+    jl_value_t *ti;   // intersection result
+    int kind;         // 0 if empty
+    int value;        // predicate result
+} typememo_entry_t;
+
+static typememo_entry_t typememo[TYPEMEMO_SIZE];
+// nonzero while inst_type_w_ is building a type, whose supertype and
+// fields are not final yet.
+static int typememo_frozen = 0;
+static size_t typememo_hits[TYPEMEMO_NKINDS];
+static size_t typememo_misses[TYPEMEMO_NKINDS];
+
+static typememo_entry_t *typememo_slot(jl_value_t *a, jl_value_t *b, int kind)
+{
+    uptrint_t h = inthash(((uptrint_t)a>>3) ^ inthash(((uptrint_t)b>>3) + kind));
+    return &typememo[h & (TYPEMEMO_SIZE-1)];
+}
+
+static int typememo_ok(jl_value_t *a, jl_value_t *b)
+{
+    return (jl_is_datatype(a) || jl_is_uniontype(a)) &&
+        (jl_is_datatype(b) || jl_is_uniontype(b)) &&
+        !jl_has_typevars_(a,1) && !jl_has_typevars_(b,1);
+}
+
+static typememo_entry_t *typememo_lookup(jl_value_t *a, jl_value_t *b, int kind)
+{
+    typememo_entry_t *e = typememo_slot(a, b, kind);
+    if (e->kind == kind && e->a == a && e->b == b) {
+        typememo_hits[kind]++;
+        return e;
+    }
+    typememo_misses[kind]++;
+    return NULL;
+}
+
+static void typememo_store(jl_value_t *a, jl_value_t *b, int kind, int value, jl_value_t *ti)
+{
+    if (typememo_frozen) return;
+    typememo_entry_t *e = typememo_slot(a, b, kind);
+    e->a = a; e->b = b; e->ti = ti;
+    e->kind = kind; e->value = value;
+}
+
+void jl_typememo_clear(void)
+{
+    memset(typememo, 0, sizeof(typememo));
+}
+
+void jl_typememo_sweep(int (*alive)(jl_value_t*))
+{
+    for(size_t i=0; i < TYPEMEMO_SIZE; i++) {
+        typememo_entry_t *e = &typememo[i];
+        if (e->kind != 0 &&
+            (!alive(e->a) || !alive(e->b) || (e->ti != NULL && !alive(e->ti))))
+            e->kind = 0;
+    }
+}
+
+// hits and misses for each kind of query, in the order subtype,
+// invariant subtype, morespecific, intersection
+DLLEXPORT void jl_typememo_counts(size_t *counts)
+{
+    for(int k=TYPEMEMO_SUBTYPE; k < TYPEMEMO_NKINDS; k++) {
+        counts[2*(k-1)]   = typememo_hits[k];
+        counts[2*(k-1)+1] = typememo_misses[k];
+    }
+}
+
 jl_value_t *jl_type_intersection(jl_value_t *a, jl_value_t *b)
 {
     jl_tuple_t *env = jl_null;
@@ -1342,8 +1429,25 @@ void print_env(cenv_t *soln)
 }
 */
 
+static jl_value_t *type_intersection_matching_(jl_value_t *a, jl_value_t *b,
+                                               jl_tuple_t **penv, jl_tuple_t *tvars);
+
 jl_value_t *jl_type_intersection_matching(jl_value_t *a, jl_value_t *b,
                                           jl_tuple_t **penv, jl_tuple_t *tvars)
+{
+    // with no typevars anywhere, the environment stays empty
+    if (tvars != jl_null || !typememo_ok(a, b))
+        return type_intersection_matching_(a, b, penv, tvars);
+    typememo_entry_t *e = typememo_lookup(a, b, TYPEMEMO_INTERSECT);
+    if (e != NULL)
+        return e->ti;
+    jl_value_t *ti = type_intersection_matching_(a, b, penv, tvars);
+    typememo_store(a, b, TYPEMEMO_INTERSECT, 0, ti);
+    return ti;
+}
+
+static jl_value_t *type_intersection_matching_(jl_value_t *a, jl_value_t *b,
+                                               jl_tuple_t **penv, jl_tuple_t *tvars)
 {
     jl_value_t **rts;
     JL_GC_PUSHARGS(rts, 1 + 2*MAX_CENV_SIZE);
@@ -1683,6 +1787,82 @@ jl_value_t *jl_apply_type(jl_value_t *tc, jl_tuple_t *params)
     return t;
 }
 
+// type cache -----------------------------------------------------------------
+
+// Instances of a parametric type are cached in tn->cache, an open-addressed
+// hash table keyed on a structural hash of their parameters that agrees
+// with type_eqv_. Parameters with no such hash (unions, whose equality is
+// extensional, and values other than symbols and isbits values) put the
+// instance in tn->linearcache instead, which is searched linearly. So are
+// instances cached during bootstrap, before Arrays exist.
+
+#define typecache_max_probe(sz) ((sz)<=1024 ? 16 : (sz)>>6)
+
+static uptrint_t hash_combine(uptrint_t h, uptrint_t x)
+{
+    return inthash(h ^ (x + 0x9e3779b9 + (h<<6) + (h>>2)));
+}
+
+// 0 means "no structural hash"
+static uptrint_t type_param_hash(jl_value_t *p)
+{
+    uptrint_t h, hp;
+    size_t i;
+    if (jl_is_typector(p))
+        p = (jl_value_t*)((jl_typector_t*)p)->body;
+    if (jl_is_typevar(p)) {
+        h = type_param_hash(((jl_tvar_t*)p)->ub);
+        hp = type_param_hash(((jl_tvar_t*)p)->lb);
+        if (h == 0 || hp == 0) return 0;
+        h = hash_combine(hash_combine(0x7e, h), hp);
+    }
+    else if (jl_is_tuple(p)) {
+        size_t l = jl_tuple_len(p);
+        int sq = (l > 0 && jl_is_vararg_type(jl_tupleref(p,l-1)));
+        h = hash_combine(0x70, (l<<1) | sq);
+        for(i=0; i < l; i++) {
+            jl_value_t *e = jl_tupleref(p,i);
+            if (jl_is_vararg_type(e)) e = jl_tparam0(e);
+            hp = type_param_hash(e);
+            if (hp == 0) return 0;
+            h = hash_combine(h, hp);
+        }
+    }
+    else if (jl_is_uniontype(p)) {
+        return 0;
+    }
+    else if (jl_is_datatype(p)) {
+        jl_datatype_t *dt = (jl_datatype_t*)p;
+        h = dt->name->name->hash;
+        for(i=0; i < jl_tuple_len(dt->parameters); i++) {
+            hp = type_param_hash(jl_tupleref(dt->parameters,i));
+            if (hp == 0) return 0;
+            h = hash_combine(h, hp);
+        }
+    }
+    else if (jl_is_symbol(p)) {
+        h = ((jl_sym_t*)p)->hash;
+    }
+    else {
+        jl_value_t *t = (jl_value_t*)jl_typeof(p);
+        if (!jl_isbits(t)) return 0;
+        h = hash_combine(((jl_datatype_t*)t)->name->name->hash,
+                         memhash((char*)jl_data_ptr(p), jl_datatype_size(t)));
+    }
+    return h == 0 ? 1 : h;
+}
+
+static uptrint_t typekey_hash(jl_value_t **key, size_t n)
+{
+    uptrint_t h = n;
+    for(size_t j=0; j < n; j++) {
+        uptrint_t hp = type_param_hash(key[j]);
+        if (hp == 0) return 0;
+        h = hash_combine(h, hp);
+    }
+    return h == 0 ? 1 : h;
+}
+
 static int typekey_compare(jl_datatype_t *tt, jl_value_t **key, size_t n)
 {
     size_t j;
@@ -1693,10 +1873,36 @@ static int typekey_compare(jl_datatype_t *tt, jl_value_t **key, size_t n)
     return 1;
 }
 
+static int typekey_match(jl_typename_t *tn, jl_datatype_t *tt, jl_value_t **key, size_t n)
+{
+    if (!typekey_compare(tt, key, n))
+        return 0;
+    // Type{T} and Type{typector} are distinct
+    if (tn == jl_type_type->name &&
+        (jl_is_typector(key[0]) != jl_is_typector(jl_tupleref(tt->parameters,0))))
+        return 0;
+    return 1;
+}
+
 static jl_value_t *lookup_type(jl_typename_t *tn, jl_value_t **key, size_t n)
 {
     if (n==0) return NULL;
-    jl_value_t *cache = tn->cache;
+    uptrint_t hv = typekey_hash(key, n);
+    if (hv != 0 && jl_is_array(tn->cache)) {
+        jl_array_t *cache = (jl_array_t*)tn->cache;
+        jl_datatype_t **tab = (jl_datatype_t**)jl_array_data(cache);
+        size_t sz = jl_array_len(cache);
+        size_t index = hv & (sz-1);
+        for(size_t iter=0; iter < sz; iter++) {
+            jl_datatype_t *tt = tab[index];
+            if (tt == NULL)
+                break;
+            if (typekey_match(tn, tt, key, n))
+                return (jl_value_t*)tt;
+            index = (index+1) & (sz-1);
+        }
+    }
+    jl_value_t *cache = tn->linearcache;
     jl_value_t **data;
     size_t cl;
     if (jl_is_tuple(cache)) {
@@ -1710,16 +1916,65 @@ static jl_value_t *lookup_type(jl_typename_t *tn, jl_value_t **key, size_t n)
     for(size_t i=0; i < cl; i++) {
         jl_datatype_t *tt = (jl_datatype_t*)data[i];
         assert(jl_is_datatype(tt));
-        if (typekey_compare(tt, key, n)) {
-            if (tn == jl_type_type->name &&
-                (jl_is_typector(key[0]) != jl_is_typector(jl_tupleref(tt->parameters,0))))
-                continue;
+        if (typekey_match(tn, tt, key, n))
             return (jl_value_t*)tt;
-        }
     }
     return NULL;
 }
 
+// returns 0 if no free slot is found within the probe limit
+static int typecache_insert(jl_array_t *cache, jl_datatype_t *type, uptrint_t hv, size_t maxprobe)
+{
+    jl_datatype_t **tab = (jl_datatype_t**)jl_array_data(cache);
+    size_t sz = jl_array_len(cache);
+    size_t index = hv & (sz-1);
+    for(size_t iter=0; iter <= maxprobe && iter < sz; iter++) {
+        if (tab[index] == NULL) {
+            tab[index] = type;
+            return 1;
+        }
+        index = (index+1) & (sz-1);
+    }
+    return 0;
+}
+
+static void typecache_rehash(jl_typename_t *tn, size_t newsz)
+{
+    jl_value_t *old = tn->cache;
+    JL_GC_PUSH1(&old);
+    jl_array_t *nc = jl_alloc_cell_1d(newsz);
+    if (jl_is_array(old)) {
+        jl_datatype_t **tab = (jl_datatype_t**)jl_array_data(old);
+        for(size_t i=0; i < jl_array_len(old); i++) {
+            jl_datatype_t *tt = tab[i];
+            if (tt != NULL) {
+                uptrint_t hv = typekey_hash(tt->parameters->data, jl_tuple_len(tt->parameters));
+                int ok = typecache_insert(nc, tt, hv, newsz);
+                assert(ok); (void)ok;
+            }
+        }
+    }
+    tn->cache = (jl_value_t*)nc;
+    JL_GC_POP();
+}
+
+static void typecache_put(jl_typename_t *tn, jl_datatype_t *type, uptrint_t hv)
+{
+    while (1) {
+        if (jl_is_array(tn->cache)) {
+            jl_array_t *cache = (jl_array_t*)tn->cache;
+            size_t sz = jl_array_len(cache);
+            if (typecache_insert(cache, type, hv, typecache_max_probe(sz)))
+                return;
+            // grow fast; rehashing all the keys repeatedly is expensive
+            typecache_rehash(tn, sz <= (1<<8) || sz >= (1<<19) ? sz<<1 : sz<<2);
+        }
+        else {
+            typecache_rehash(tn, 16);
+        }
+    }
+}
+
 static int t_uid_ctr = 1;
 
 int  jl_get_t_uid_ctr(void) { return t_uid_ctr; }
@@ -1751,7 +2006,15 @@ static void cache_type_(jl_value_t *type)
     // assign uid
     if (!jl_is_abstracttype(type) && ((jl_datatype_t*)type)->uid==0)
         ((jl_datatype_t*)type)->uid = jl_assign_type_uid();
-    jl_value_t *cache = ((jl_datatype_t*)type)->name->cache;
+    jl_typename_t *tn = ((jl_datatype_t*)type)->name;
+    if (jl_array_any_type != NULL) {
+        uptrint_t hv = typekey_hash(t->data, jl_tuple_len(t));
+        if (hv != 0) {
+            typecache_put(tn, (jl_datatype_t*)type, hv);
+            return;
+        }
+    }
+    jl_value_t *cache = tn->linearcache;
     // this needs to work before jl_array_any_type exists, so start with
     // a tuple and switch to an Array when possible.
     if (jl_array_any_type != NULL) {
@@ -1759,7 +2022,7 @@ static void cache_type_(jl_value_t *type)
             jl_array_t *nc = jl_alloc_cell_1d(jl_tuple_len(cache));
             memcpy(nc->data, ((jl_tuple_t*)cache)->data, sizeof(void*)*jl_tuple_len(cache));
             cache = (jl_value_t*)nc;
-            ((jl_datatype_t*)type)->name->cache = cache;
+            tn->linearcache = cache;
         }
         assert(jl_is_array(cache));
         jl_cell_1d_push((jl_array_t*)cache, (jl_value_t*)type);
@@ -1770,7 +2033,7 @@ static void cache_type_(jl_value_t *type)
         jl_tuple_t *nc = jl_alloc_tuple_uninit(n+1);
         memcpy(nc->data, ((jl_tuple_t*)cache)->data, sizeof(void*) * n);
         jl_tupleset(nc, n, (jl_value_t*)type);
-        ((jl_datatype_t*)type)->name->cache = (jl_value_t*)nc;
+        tn->linearcache = (jl_value_t*)nc;
     }
 }
 
@@ -1926,43 +2189,53 @@ static jl_value_t *inst_type_w_(jl_value_t *t, jl_value_t **env, size_t n,
         top.tt = (jl_datatype_t*)ndt;
         top.prev = stack;
         stack = &top;
-        ndt->name = tn;
-        ndt->super = jl_any_type;
-        ndt->parameters = iparams_tuple;
-        ndt->names = dt->names;
-        ndt->types = jl_null; // to be filled in below
-        if (isabstract || !jl_is_function(dt->ctor_factory))
-            ndt->fptr = jl_f_no_function;
-        else
-            ndt->fptr = jl_f_ctor_trampoline;
-        ndt->mutabl = dt->mutabl;
-        ndt->abstract = dt->abstract;
-        ndt->env = (jl_value_t*)ndt;
-        ndt->linfo = NULL;
-        ndt->ctor_factory = dt->ctor_factory;
-        ndt->instance = NULL;
-        ndt->uid = 0;
-        ndt->struct_decl = NULL;
-        ndt->size = ndt->alignment = 0;
-        ndt->super = (jl_datatype_t*)inst_type_w_((jl_value_t*)dt->super, env,n,stack, 1);
-        ftypes = dt->types;
-        if (ftypes != NULL) {
-            // recursively instantiate the types of the fields
-            ndt->types = (jl_tuple_t*)inst_type_w_((jl_value_t*)ftypes, env, n, stack, 1);
-            if (!isabstract) {
-                jl_compute_field_offsets(ndt);
-            }
-            else {
-                ndt->size = 0;
-                ndt->pointerfree = 0;
-            }
-            if (tn == jl_array_typename)
-                ndt->pointerfree = 0;
-            if (jl_tuple_len(ftypes) == 0) {
-                ndt->alignment = ndt->size = dt->size;
-                ndt->pointerfree = dt->pointerfree;
+        typememo_frozen++;
+        JL_TRY {
+            ndt->name = tn;
+            ndt->super = jl_any_type;
+            ndt->parameters = iparams_tuple;
+            ndt->names = dt->names;
+            ndt->types = jl_null; // to be filled in below
+            if (isabstract || !jl_is_function(dt->ctor_factory))
+                ndt->fptr = jl_f_no_function;
+            else
+                ndt->fptr = jl_f_ctor_trampoline;
+            ndt->mutabl = dt->mutabl;
+            ndt->abstract = dt->abstract;
+            ndt->env = (jl_value_t*)ndt;
+            ndt->linfo = NULL;
+            ndt->ctor_factory = dt->ctor_factory;
+            ndt->instance = NULL;
+            ndt->uid = 0;
+            ndt->struct_decl = NULL;
+            ndt->size = ndt->alignment = 0;
+            ndt->super = (jl_datatype_t*)inst_type_w_((jl_value_t*)dt->super, env,n,stack, 1);
+            ftypes = dt->types;
+            if (ftypes != NULL) {
+                // recursively instantiate the types of the fields
+                ndt->types = (jl_tuple_t*)inst_type_w_((jl_value_t*)ftypes, env, n, stack, 1);
+                if (!isabstract) {
+                    jl_compute_field_offsets(ndt);
+                }
+                else {
+                    ndt->size = 0;
+                    ndt->pointerfree = 0;
+                }
+                if (tn == jl_array_typename)
+                    ndt->pointerfree = 0;
+                if (jl_tuple_len(ftypes) == 0) {
+                    ndt->alignment = ndt->size = dt->size;
+                    ndt->pointerfree = dt->pointerfree;
+                }
             }
         }
+        JL_CATCH {
+            // e.g. a parameter out of bounds in a field type; callers such
+            // as jl_type_intersection_matching may catch this and go on
+            typememo_frozen--;
+            jl_rethrow();
+        }
+        typememo_frozen--;
         if (cacheable) cache_type_((jl_value_t*)ndt);
         result = (jl_value_t*)ndt;
 
@@ -2252,14 +2525,29 @@ static int jl_subtype_le(jl_value_t *a, jl_value_t *b, int ta, int invariant)
     return jl_egal(a, b);
 }
 
+static int subtype_memo(jl_value_t *a, jl_value_t *b, int invariant)
+{
+    int kind = invariant ? TYPEMEMO_SUBTYPE_INV : TYPEMEMO_SUBTYPE;
+    if (!typememo_ok(a, b))
+        return jl_subtype_le(a, b, 0, invariant);
+    typememo_entry_t *e = typememo_lookup(a, b, kind);
+    if (e != NULL)
+        return e->value;
+    int v = jl_subtype_le(a, b, 0, invariant);
+    typememo_store(a, b, kind, v, NULL);
+    return v;
+}
+
 int jl_subtype(jl_value_t *a, jl_value_t *b, int ta)
 {
-    return jl_subtype_le(a, b, ta, 0);
+    if (ta) return jl_subtype_le(a, b, ta, 0);
+    return subtype_memo(a, b, 0);
 }
 
 int jl_subtype_invariant(jl_value_t *a, jl_value_t *b, int ta)
 {
-    return jl_subtype_le(a, b, ta, 1);
+    if (ta) return jl_subtype_le(a, b, ta, 1);
+    return subtype_memo(a, b, 1);
 }
 
 // specificity comparison
@@ -2506,7 +2794,14 @@ static int jl_type_morespecific_(jl_value_t *a, jl_value_t *b, int invariant)
 
 int jl_type_morespecific(jl_value_t *a, jl_value_t *b)
 {
-    return jl_type_morespecific_(a, b, 0);
+    if (!typememo_ok(a, b))
+        return jl_type_morespecific_(a, b, 0);
+    typememo_entry_t *e = typememo_lookup(a, b, TYPEMEMO_MORESPECIFIC);
+    if (e != NULL)
+        return e->value;
+    int v = jl_type_morespecific_(a, b, 0);
+    typememo_store(a, b, TYPEMEMO_MORESPECIFIC, v, NULL);
+    return v;
 }
 
 
@@ -2842,7 +3137,7 @@ void jl_init_types(void)
     // create base objects
     jl_datatype_type = jl_new_uninitialized_datatype(14);
     jl_datatype_type->type = (jl_value_t*)jl_datatype_type;
-    jl_typename_type = jl_new_uninitialized_datatype(4);
+    jl_typename_type = jl_new_uninitialized_datatype(5);
     jl_sym_type = jl_new_uninitialized_datatype(0);
     jl_symbol_type = jl_sym_type;
 
@@ -2902,11 +3197,12 @@ void jl_init_types(void)
     jl_typename_type->name->primary = (jl_value_t*)jl_typename_type;
     jl_typename_type->super = jl_any_type;
     jl_typename_type->parameters = jl_null;
-    jl_typename_type->names = jl_tuple(4, jl_symbol("name"),
+    jl_typename_type->names = jl_tuple(5, jl_symbol("name"),
                                        jl_symbol("module"),
-                                       jl_symbol("primary"), jl_symbol(""));
-    jl_typename_type->types = jl_tuple(4, jl_sym_type, jl_any_type,
-                                       jl_type_type, jl_any_type);
+                                       jl_symbol("primary"), jl_symbol(""),
+                                       jl_symbol(""));
+    jl_typename_type->types = jl_tuple(5, jl_sym_type, jl_any_type,
+                                       jl_type_type, jl_any_type, jl_any_type);
     jl_typename_type->uid = jl_assign_type_uid();
     jl_typename_type->fptr = jl_f_no_function;
     jl_typename_type->env = (jl_value_t*)jl_null;
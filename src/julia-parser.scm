@@ -148,13 +148,6 @@
     (lambda (c) (memv c chrs))))
 (define (newline? c) (eqv? c #\newline))
 
-(define (skip-to-eol port)
-  (let ((c (peek-char port)))
-    (cond ((eof-object? c)    c)
-	  ((eqv? c #\newline) c)
-	  (else               (read-char port)
-			      (skip-to-eol port)))))
-
 (define (read-operator port c)
   (if (and (eqv? c #\*) (eqv? (peek-char port) #\*))
       (error "use \"^\" instead of \"**\""))
@@ -372,33 +365,7 @@
        (eq? (car t) 'macrocall)
        (memq (cadr t) '(@int128_str @uint128_str @bigint_str))))
 
-; skip to end of comment, starting at #:  either #...<eol> or #= .... =#.
-(define (skip-comment port)
-  (define (skip-multiline-comment port count)
-    (let ((c (read-char port)))
-      (if (eof-object? c) 
-          (error "incomplete: unterminated multi-line comment #= ... =#") ; NOTE: changing this may affect code in base/client.jl
-          (begin (if (eqv? c #\=)
-                     (let ((c (peek-char port)))
-                       (if (eqv? c #\#)
-			   (begin
-			     (read-char port)
-			     (if (> count 1)
-				 (skip-multiline-comment port (- count 1))))
-                           (skip-multiline-comment port count)))
-		     (if (eqv? c #\#)
-			 (skip-multiline-comment port
-						 (if (eqv? (peek-char port) #\=)
-						     (begin (read-char port)
-							    (+ count 1))
-						     count))
-			 (skip-multiline-comment port count)))))))
-
-  (read-char port) ; read # that was already peeked
-  (if (eqv? (peek-char port) #\=)
-      (begin (read-char port) ; read initial =
-	     (skip-multiline-comment port 1))
-      (skip-to-eol port)))
+; skip-comment is implemented in C (flisp/julia_extensions.c)
 
 (define (skip-ws-and-comments port)
   (skip-ws port #t)
@@ -65,8 +65,6 @@ typedef struct _jl_value_t {
 
 typedef struct _jl_sym_t {
     JL_DATA_TYPE
-    struct _jl_sym_t *left;
-    struct _jl_sym_t *right;
     uptrint_t hash;    // precomputed hash value
     JL_ATTRIBUTE_ALIGN_PTRSIZE(char name[]);
 } jl_sym_t;
@@ -187,7 +185,8 @@ typedef struct {
     // a type alias, for example, might make a type constructor that is
     // not the original.
     jl_value_t *primary;
-    jl_value_t *cache;
+    jl_value_t *cache;        // hash table of instances, see jltypes.c
+    jl_value_t *linearcache;  // instances without a structural hash
 } jl_typename_t;
 
 typedef struct {
@@ -668,7 +667,7 @@ DLLEXPORT jl_sym_t *jl_symbol_lookup(const char *str);
 DLLEXPORT jl_sym_t *jl_symbol_n(const char *str, int32_t len);
 DLLEXPORT jl_sym_t *jl_gensym(void);
 DLLEXPORT jl_sym_t *jl_tagged_gensym(const char *str, int32_t len);
-DLLEXPORT jl_sym_t *jl_get_root_symbol(void);
+void jl_foreach_symbol(void (*f)(jl_sym_t*, void*), void *data);
 jl_expr_t *jl_exprn(jl_sym_t *head, size_t n);
 jl_function_t *jl_new_generic_function(jl_sym_t *name);
 void jl_add_method(jl_function_t *gf, jl_tuple_t *types, jl_function_t *meth,
@@ -750,7 +749,7 @@ DLLEXPORT jl_array_t *jl_ptr_to_array_1d(jl_value_t *atype, void *data,
                                          size_t nel, int own_buffer);
 DLLEXPORT jl_array_t *jl_ptr_to_array(jl_value_t *atype, void *data,
                                       jl_tuple_t *dims, int own_buffer);
-int jl_array_store_unboxed(jl_value_t *el_type);
+DLLEXPORT int jl_array_store_unboxed(jl_value_t *el_type);
 
 DLLEXPORT jl_array_t *jl_alloc_array_1d(jl_value_t *atype, size_t nr);
 DLLEXPORT jl_array_t *jl_alloc_array_2d(jl_value_t *atype, size_t nr, size_t nc);
@@ -1274,6 +1273,7 @@ DLLEXPORT jl_array_t *jl_takebuf_array(ios_t *s);
 DLLEXPORT jl_value_t *jl_takebuf_string(ios_t *s);
 DLLEXPORT void *jl_takebuf_raw(ios_t *s);
 DLLEXPORT jl_value_t *jl_readuntil(ios_t *s, uint8_t delim);
+DLLEXPORT size_t jl_readuntil_into(jl_array_t *a, ios_t *s, uint8_t delim);
 DLLEXPORT void jl_free2(void *p, void *hint);
 
 typedef struct {
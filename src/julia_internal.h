@@ -21,6 +21,23 @@ STATIC_INLINE jl_value_t *newstruct(jl_datatype_t *type)
     return jv;
 }
 
+// arrays of immutables that have reference fields store their elements inline;
+// such an element is unassigned while its first reference field is NULL
+STATIC_INLINE int jl_array_hasptrs(jl_array_t *a)
+{
+    return !a->ptrarray && !jl_is_pointerfree(jl_tparam0(jl_typeof(a)));
+}
+
+STATIC_INLINE int jl_first_ptr_field(jl_datatype_t *dt)
+{
+    size_t i, nf = jl_tuple_len(dt->names);
+    for(i=0; i < nf; i++) {
+        if (dt->fields[i].isptr)
+            return dt->fields[i].offset;
+    }
+    return -1;
+}
+
 int jl_assign_type_uid(void);
 jl_value_t *jl_cache_type_(jl_datatype_t *type);
 int  jl_get_t_uid_ctr(void);
@@ -71,6 +88,7 @@ jl_value_t *jl_type_match_morespecific(jl_value_t *a, jl_value_t *b);
 int jl_types_equal_generic(jl_value_t *a, jl_value_t *b, int useenv);
 
 void jl_set_datatype_super(jl_datatype_t *tt, jl_value_t *super);
+void jl_typememo_clear(void);
 void jl_initialize_generic_function(jl_function_t *f, jl_sym_t *name);
 
 void jl_compute_field_offsets(jl_datatype_t *st);
@@ -243,6 +243,39 @@ size_t u8_charnum(const char *s, size_t offset)
     return charnum;
 }
 
+// Word-at-a-time helpers: ONE_BYTES has 0x01 in every byte of a word and
+// HIGH_BYTES has 0x80 in every byte. Loads go through memcpy so that they
+// are allowed at any alignment and do not break strict aliasing.
+#define ONE_BYTES  (~(size_t)0/0xff)
+#define HIGH_BYTES (ONE_BYTES*0x80)
+
+static inline size_t load_word(const unsigned char *p)
+{
+    size_t w;
+    memcpy(&w, p, sizeof(size_t));
+    return w;
+}
+
+/* number of characters in the first len bytes of s (which need not be
+   NUL-terminated): every byte that is not a continuation byte starts one */
+size_t u8_charcount(const char *s, size_t len)
+{
+    const unsigned char *p = (const unsigned char*)s;
+    const unsigned char *pend = p + len;
+    size_t ncont = 0;
+    for (; p + sizeof(size_t) <= pend; p += sizeof(size_t)) {
+        size_t w = load_word(p);
+        // bit 7 of each byte that looks like 10xxxxxx
+        size_t m = w & ~(w << 1) & HIGH_BYTES;
+        // add up the flags (at most 8) in the top byte
+        ncont += ((m >> 7) * ONE_BYTES) >> ((sizeof(size_t)-1)*8);
+    }
+    for (; p < pend; p++) {
+        ncont += ((*p & 0xc0) == 0x80);
+    }
+    return len - ncont;
+}
+
 /* number of characters in NUL-terminated string */
 size_t u8_strlen(const char *s)
 {
@@ -649,6 +682,11 @@ int u8_isvalid(const char *str, size_t length)
     int ab;
 
     for (p = (unsigned char*)str; p < pend; p++) {
+        // skip runs of ASCII a word at a time
+        while (p + sizeof(size_t) <= pend && (load_word(p) & HIGH_BYTES) == 0)
+            p += sizeof(size_t);
+        if (p >= pend)
+            break;
         c = *p;
         if (c < 128)
             continue;
@@ -656,9 +694,9 @@ int u8_isvalid(const char *str, size_t length)
         if ((c & 0xc0) != 0xc0)
             return 0;
         ab = trailingBytesForUTF8[c];
-        if (length < ab)
+        /* the sequence must end within the buffer */
+        if (pend - p <= ab)
             return 0;
-        length -= ab;
 
         p++;
         /* Check top bits in the second byte */
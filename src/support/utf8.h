@@ -96,6 +96,9 @@ char *u8_memrchr(const char *s, uint32_t ch, size_t sz);
 /* count the number of characters in a UTF-8 string */
 DLLEXPORT size_t u8_strlen(const char *s);
 
+/* same, for len bytes that need not be NUL-terminated */
+DLLEXPORT size_t u8_charcount(const char *s, size_t len);
+
 /* number of columns occupied by a string */
 DLLEXPORT size_t u8_strwidth(const char *s);
 
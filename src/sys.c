@@ -297,6 +297,32 @@ jl_value_t *jl_readuntil(ios_t *s, uint8_t delim)
     return (jl_value_t*)a;
 }
 
+// like jl_readuntil, but appends to an existing array so that a caller
+// reading many lines can reuse one buffer
+size_t jl_readuntil_into(jl_array_t *a, ios_t *s, uint8_t delim)
+{
+    size_t total = 0, avail = s->size - s->bpos;
+    while (!ios_eof(s)) {
+        if (avail == 0) {
+            avail = ios_readprep(s, 160);
+            if (avail == 0)
+                break;
+        }
+        char *from = s->buf+s->bpos;
+        char *pd = (char*)memchr(from, delim, avail);
+        size_t n = pd ? (size_t)(pd-from+1) : avail;
+        jl_array_grow_end(a, n);
+        memcpy((char*)jl_array_data(a)+jl_array_len(a)-n, from, n);
+        s->bpos += n;
+        total += n;
+        if (pd)
+            return total;
+        avail = 0;
+    }
+    s->_eof = 1;
+    return total;
+}
+
 void jl_free2(void *p, void *hint)
 {
     free(p);
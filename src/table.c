@@ -29,6 +29,7 @@ static void **jl_table_lookup_bp(jl_array_t **pa, void *key)
     size_t newsz, sz = hash_size(a);
     size_t maxprobe = max_probe(sz);
     void **tab = (void**)a->data;
+    void **avail;
 
     hv = keyhash((jl_value_t*)key);
  retry_bp:
@@ -36,22 +37,34 @@ static void **jl_table_lookup_bp(jl_array_t **pa, void *key)
     index = h2index(hv,sz);
     sz *= 2;
     orig = index;
+    avail = NULL;
 
     do {
-        if (tab[index+1] == NULL) {
-            tab[index] = key;
-            return &tab[index+1];
+        if (tab[index] == NULL) {
+            if (avail == NULL)
+                avail = &tab[index];
+            break;
         }
 
         if (jl_egal((jl_value_t*)key, (jl_value_t*)tab[index]))
             return &tab[index+1];
 
+        // a deleted entry can be reused, but only once we know the key
+        // is not stored further along the chain
+        if (tab[index+1] == NULL && avail == NULL)
+            avail = &tab[index];
+
         index = (index+2) & (sz-1);
         iter++;
         if (iter > maxprobe)
             break;
     } while (index != orig);
 
+    if (avail != NULL) {
+        avail[0] = key;
+        return &avail[1];
+    }
+
     /* table full */
     /* quadruple size, rehash, retry the insert */
     /* it's important to grow the table really fast; otherwise we waste */
@@ -128,6 +141,23 @@ jl_value_t *jl_eqtable_pop(jl_array_t *h, void *key, jl_value_t *deflt)
         return deflt;
     jl_value_t *val = (jl_value_t*)*bp;
     *bp = NULL;
+    // Deleted entries keep their key so that lookups keep probing past
+    // them. When the entry ends its probe chain, though, nothing can be
+    // stored beyond it, so it and any deleted entries just before it are
+    // cleared for good. This keeps chains short under insert/delete churn
+    // and does not keep deleted keys alive. Entries never move, so
+    // deleting while iterating is still safe.
+    void **tab = (void**)h->data;
+    size_t sz = jl_array_len(h);
+    size_t index = (bp - tab) - 1;
+    if (tab[(index+2) & (sz-1)] == NULL) {
+        size_t n = 0;
+        do {
+            tab[index] = NULL;
+            index = (index-2) & (sz-1);
+            n += 2;
+        } while (n < sz && tab[index] != NULL && tab[index+1] == NULL);
+    }
     return val;
 }
 
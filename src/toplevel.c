@@ -591,8 +591,11 @@ void jl_set_datatype_super(jl_datatype_t *tt, jl_value_t *super)
         jl_errorf("invalid subtyping in definition of %s",tt->name->name->name);
     }
     tt->super = (jl_datatype_t*)super;
+    // answers involving tt may have been remembered before it had a supertype
+    jl_typememo_clear();
     if (jl_tuple_len(tt->parameters) > 0) {
         tt->name->cache = (jl_value_t*)jl_null;
+        tt->name->linearcache = (jl_value_t*)jl_null;
         jl_reinstantiate_inner_types(tt);
     }
 }
@@ -893,3 +893,53 @@ function i7197()
     ind2sub(size(S), 5)
 end
 @test i7197() == (2,2)
+
+# StructOfArrays
+immutable SoATestRec
+    id::Int
+    name::ASCIIString
+    w::Float64
+end
+recs = [SoATestRec(i, string("r", i), i/2) for i = 1:6]
+S = convert(StructOfArrays, recs)
+@test size(S) == (6,)
+@test S[3] == recs[3]
+@test S.arrays[1] == [1:6]
+@test S.arrays[3] == [0.5:0.5:3.0]
+S[2] = SoATestRec(20, "x", 0.0)
+@test S[2].id == 20 && S.arrays[2][2] == "x"
+@test_throws BoundsError S[7]
+S2 = StructOfArrays(SoATestRec, 2, 3)
+S2[2,3] = recs[1]
+@test S2[6] == recs[1]
+@test_throws ErrorException StructOfArrays(Int, 3)
+
+# immutables with reference fields are stored inline
+immutable InlineRefRec
+    id::Int
+    name::ASCIIString
+end
+@test ccall(:jl_array_store_unboxed, Cint, (Any,), InlineRefRec) != 0
+@test ccall(:jl_array_store_unboxed, Cint, (Any,), Complex{BigInt}) == 0
+let a = Array(InlineRefRec, 3)
+    @test sizeof(a) == 3*sizeof(InlineRefRec)
+    @test !isdefined(a, 2)
+    @test_throws UndefRefError a[2]
+    for i = 1:3
+        a[i] = InlineRefRec(i, string("n", i))
+    end
+    @test isdefined(a, 2)
+    push!(a, InlineRefRec(4, "n4"))
+    unshift!(a, InlineRefRec(0, "n0"))
+    insert!(a, 3, InlineRefRec(-1, "m"))
+    deleteat!(a, 3)
+    resize!(a, 7)
+    @test !isdefined(a, 6) && !isdefined(a, 7)
+    resize!(a, 5)
+    gc()
+    @test [r.id for r in a] == [0:4]
+    @test [r.name for r in a] == ["n0", "n1", "n2", "n3", "n4"]
+    b = [copy(a), a]
+    @test b == [a, a]
+    @test a[end].name == "n4"
+end
@@ -114,3 +114,18 @@ rt = Base.return_types(broadcast, (Function, Array{Float64, 3}, Array{Int, 1}))
 @test length(rt) == 1 && rt[1] == Array{Float64, 3}
 rt = Base.return_types(broadcast!, (Function, Array{Float64, 3}, Array{Float64, 3}, Array{Int, 1}))
 @test length(rt) == 1 && rt[1] == Array{Float64, 3}
+
+# fused dotted expressions
+let a = [1.0, 2.0, 3.0], b = [4.0 5.0], c = [1, 2, 3], d = zeros(3, 2)
+    @test @broadcast(a .* b .+ c) == a .* b .+ c
+    @test @broadcast(a .+ b .- 2 .* c ./ 4) == a .+ b .- 2 .* c ./ 4
+    @test @broadcast(c .+ c .+ c) == 3c
+    @test eltype(@broadcast(c .+ c)) == Int
+    @test eltype(@broadcast(c ./ c)) == Float64
+    @test @broadcast(c .// c) == c .// c
+    @test @broadcast(a .* sum(a)) == a * 6
+    @broadcast d a .* b .+ c
+    @test d == a .* b .+ c
+    @broadcast(a, a .^ 2)
+    @test a == [1.0, 4.0, 9.0]
+end
@@ -223,6 +223,37 @@ for k5886 in keys(d5886)
    d5886[k5886] += 1
 end
 
+# keys whose slot tags all collide (the tag is the top bits of the hash),
+# with runs of four equal hashes, across deletions and reinsertions
+immutable TagCollideKey
+    x::Int
+end
+Base.hash(k::TagCollideKey, h::Uint) = uint(k.x >> 2)
+let d = Dict{TagCollideKey,Int}()
+    for i = 1:200
+        d[TagCollideKey(i)] = i
+    end
+    for i = 2:2:200
+        delete!(d, TagCollideKey(i))
+    end
+    @test length(d) == 100
+    for i = 1:200
+        @test get(d, TagCollideKey(i), 0) == (isodd(i) ? i : 0)
+    end
+    for i = 2:4:200
+        d[TagCollideKey(i)] = -i
+    end
+    @test get!(d, TagCollideKey(4), -4) == -4
+    @test get!(d, TagCollideKey(1), 0) == 1
+    @test length(d) == 151
+    for i = 1:200
+        v = isodd(i) ? i : (i%4 == 2 || i == 4) ? -i : 0
+        @test get(d, TagCollideKey(i), 0) == v
+    end
+    @test !haskey(d, TagCollideKey(8))
+    @test sort!([k.x for k in keys(d)]) == sort!([1:2:200, 2:4:200, 4])
+end
+
 # ############# end of dict tests #############
 
 # #################### set ####################
@@ -473,3 +504,24 @@ s = IntSet(0,1,10,20,200,300,1000,10000,10002)
 
 @test isempty((1:4)[5:4])
 @test_throws BoundsError (1:10)[8:-1:-2]
+
+# ObjectIdDict with deletions interleaved with insertions
+let d = ObjectIdDict(), ks = {string(i) for i = 1:2000}
+    for r = 1:3
+        for k in ks
+            d[k] = r
+        end
+        for i = 1:2:length(ks)
+            delete!(d, ks[i])
+        end
+        for i = 1:2:length(ks)
+            d[ks[i]] = -r
+        end
+    end
+    @test length(d) == length(ks)
+    @test all(i->d[ks[i]] == (isodd(i) ? -3 : 3), 1:length(ks))
+    for k in ks
+        pop!(d, k)
+    end
+    @test isempty(d)
+end
@@ -1761,3 +1761,66 @@ function test7302()
     convert(t, "5")
 end
 @test_throws MethodError test7302()
+
+# inlining hints
+@noinline noinline_callee(x) = x+1
+@inline function inline_callee(x)
+    x+1
+end
+inline_caller(x) = noinline_callee(x) + inline_callee(x)
+@test inline_caller(1) == 4
+let decisions = [ (r[1], r[5]) for r in inlining_report(inline_caller, (Int,)) ]
+    @test in((noinline_callee, :noinline), decisions)
+    @test in((inline_callee, :forced), decisions)
+end
+# the marker statement is removed from the method when it is defined
+for f in (noinline_callee, inline_callee)
+    @test !any(x->isa(x,QuoteNode), code_typed(f, (Int,))[1].args[3].args)
+end
+@test Base.inline_hints[methods(noinline_callee, (Int,))[1].func.code] === :noinline
+
+# branches decided by constants or by inferred types are pruned
+fold_branch(x::Int) = isa(x, String) ? "s" : (is(x, nothing) ? 0 : x+1)
+@test fold_branch(1) == 2
+let body = code_typed(fold_branch, (Int,))[1].args[3].args
+    @test !any(st->isa(st,Expr) && st.head === :gotoifnot, body)
+end
+# but not when the argument types are abstract and only appear disjoint
+fold_abstract(x::Integer, y::Real) = (is(x, y), isa(x, Signed), isa(y, Type{Int}))
+@test fold_abstract(1, 1) == (true, true, false)
+@test fold_abstract(0x1, 1.0) == (false, false, false)
+fold_typeof(x::ANY) = isa(typeof(x), DataType) ? (is(typeof(x), Int) ? 1 : 2) : 3
+@test fold_typeof(1) == 1
+@test fold_typeof(1.0) == 2
+@test fold_typeof(Union(Int,String)) == 3
+
+# type cache: instances of parametric types are unique
+abstract TypeCacheTest{T}
+let ts = [ TypeCacheTest{i} for i = 1:2000 ]
+    @test all(i->(TypeCacheTest{i} === ts[i]), 1:2000)
+    @test TypeCacheTest{(Int,Vararg{Int})} === TypeCacheTest{(Int,Vararg{Int})}
+    @test TypeCacheTest{:sym} === TypeCacheTest{:sym}
+    @test TypeCacheTest{Union(Int,String)} === TypeCacheTest{Union(String,Int)}
+end
+
+# memoized type queries give the same answers
+let ts = {Vector{Int}, AbstractArray{Int,1}, Integer, Signed},
+    h0 = Base.typememo_counts()[1][1]
+    for i = 1:3
+        @test issubtype(ts[1], ts[2])
+        @test !issubtype(ts[2], ts[1])
+        @test typeintersect(ts[3], ts[4]) == Signed
+        @test (Int, Vector{Int}) <: (Integer, AbstractVector)
+    end
+    @test Base.typememo_counts()[1][1] > h0
+end
+# a query made while a type is being defined, before it has its
+# supertype, is forgotten once the supertype is set
+abstract TypeMemoAbs
+typememo_seen = {}
+typememo_probe(T) = (push!(typememo_seen, T <: TypeMemoAbs); Int)
+type TypeMemoSub <: TypeMemoAbs
+    x::typememo_probe(TypeMemoSub)
+end
+@test typememo_seen == {false}
+@test TypeMemoSub <: TypeMemoAbs
@@ -257,6 +257,21 @@ touch(emptyfile)
 emptyf = open(emptyfile)
 @test isempty(readlines(emptyf))
 close(emptyf)
+
+# eachline with a reused buffer
+linesfile = joinpath(dir, "lines")
+open(f->print(f, "one\ntwo\n\nthree"), linesfile, "w")
+for s in (open(linesfile), IOBuffer(readall(linesfile)))
+    buf = Uint8[]
+    lines = {}
+    for l in eachline(s, buf)
+        @test isa(l, SubString{UTF8String})
+        push!(lines, bytestring(l))
+    end
+    @test lines == open(readlines, linesfile)
+    close(s)
+end
+rm(linesfile)
 rm(emptyfile)
 
 # Test copy file
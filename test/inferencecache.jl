@@ -0,0 +1,59 @@
+# persistent inference cache
+
+cachedir = mktempdir()
+srcdir = mktempdir()
+srcf = joinpath(srcdir, "infcache_f.jl")
+srcg = joinpath(srcdir, "infcache_g.jl")
+srch = joinpath(srcdir, "infcache_h.jl")
+# f calls g calls h, each in its own file
+open(io->println(io, "infcache_f(x) = infcache_g(x)"), srcf, "w")
+open(io->println(io, "infcache_g(x) = infcache_h(x)"), srcg, "w")
+open(io->println(io, "infcache_h(x) = x"), srch, "w")
+include(srch); include(srcg); include(srcf)
+
+function infcache_hit(f)
+    c = Base.inference_cache
+    def = methods(f, (Int,))[1].func.code
+    Base.infcache_load(c, def, (Int,), def, Base.infcache_key(c, def, (Int,))) !== nothing
+end
+
+# plain calls at top level, so that each function is compiled on its own
+# rather than inferred inside a test closure; g is compiled before f, so
+# f's inference reuses g's tree
+Base.enable_inference_cache(cachedir)
+rg = infcache_g(1)
+rf = infcache_f(2)
+@test rg == 1 && rf == 2
+@test length(filter(p->endswith(p, ".ji"), readdir(cachedir))) >= 2
+
+Base.enable_inference_cache(cachedir)
+@test infcache_hit(infcache_f)
+@test infcache_hit(infcache_g)
+
+# editing h's file invalidates g directly and f through g
+sleep(1.1)
+touch(srch)
+Base.enable_inference_cache(cachedir)
+@test !infcache_hit(infcache_g)
+@test !infcache_hit(infcache_f)
+
+# so does changing a constant another file's method folded in
+srcm = joinpath(srcdir, "infcache_m.jl")
+srcn = joinpath(srcdir, "infcache_n.jl")
+open(io->println(io, "module InfcacheM; const N = 3; end"), srcm, "w")
+open(io->println(io, "infcache_n(x) = x + InfcacheM.N"), srcn, "w")
+include(srcm); include(srcn)
+Base.enable_inference_cache(cachedir)
+rn = infcache_n(1)
+@test rn == 4
+Base.enable_inference_cache(cachedir)
+@test infcache_hit(infcache_n)
+open(io->println(io, "module InfcacheM; const N = 5; end"), srcm, "w")
+include(srcm)
+Base.enable_inference_cache(cachedir)
+@test !infcache_hit(infcache_n)
+
+Base.disable_inference_cache()
+rm(srcf); rm(srcg); rm(srch); rm(srcm); rm(srcn); rm(srcdir)
+for p in readdir(cachedir) rm(joinpath(cachedir, p)) end
+rm(cachedir)
@@ -275,6 +275,13 @@ end
 @test repr(NaN) == "NaN"
 @test repr(-NaN) == "NaN"
 @test repr(float64(pi)) == "3.141592653589793"
+@test repr(1.0e7) == "1.0e7"
+@test repr(-2.5e-5) == "-2.5e-5"
+@test repr(1.0e100) == "1.0e100"
+@test repr(5.0e-324) == "5.0e-324"
+@test repr(1.5f10) == "1.5f10"
+@test sprint(print_shortest, 1.0e22) == "1e22"
+@test sprint(print_shortest, 1.25e-300) == "125e-302"
 
 @test repr(1.0f0) == "1.0f0"
 @test repr(-1.0f0) == "-1.0f0"
@@ -290,6 +297,13 @@ end
 @test repr(-NaN32) == "NaN32"
 @test repr(float32(pi)) == "3.1415927f0"
 
+# parsing a number out of the middle of a string
+@test float64(SubString("x12.5e3", 2, 7)) == 12.5e3
+@test float64(SubString("1234", 1, 2)) == 12.0
+@test float32(SubString("1.5e3x", 1, 3)) == 1.5f0
+@test !float64_isvalid(SubString("1.5e3", 1, 4), Array(Float64,1))
+@test !float64_isvalid(SubString("12", 1, 0), Array(Float64,1))
+
 # signs
 @test sign(1) == 1
 @test sign(-1) == -1
@@ -122,6 +122,25 @@ map!(x->1, d)
 @test 2.0 == remotecall_fetch(id_other, D->D[2], Base.shmem_fill(2.0, 2; pids=[id_me, id_other]))
 @test 3.0 == remotecall_fetch(id_other, D->D[1], Base.shmem_fill(3.0, 1; pids=[id_me, id_other]))
 
+# large bits arrays passed in shared memory segments
+id_shm = remotecall_fetch(1, () -> addprocs(1; shmem=true))[1]
+# only process 1's connection to id_shm uses shared memory, so call from there
+shm_fetch(f, args...) = remotecall_fetch(1, remotecall_fetch, id_shm, f, args...)
+A = rand(100, 200)
+@test shm_fetch(x->x, A) == A
+@test shm_fetch((x,y)->(x,y), A, [1:10]) == (A, [1:10])
+@test shm_fetch(x->sum(x), A) == sum(A)
+@test shm_fetch(()->ones(Int32, 100, 1000)) == ones(Int32, 100, 1000)
+# every segment is acknowledged by its receiver
+shm_allacked() = remotecall_fetch(1, ()->isempty(Base.shmem_xfer_pending)) &&
+                 remotecall_fetch(id_shm, ()->isempty(Base.shmem_xfer_pending))
+t0 = time()
+while !shm_allacked() && time() - t0 < 10
+    sleep(0.1)
+end
+@test shm_allacked()
+remotecall_fetch(1, rmprocs, id_shm)
+
 
 end # @unix_only(SharedArray tests)
 
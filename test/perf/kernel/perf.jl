@@ -217,3 +217,151 @@ logical_y = map(iseven, 1:length(x))
 @timeit (for n=1:100 add1!(x,logical_y) end) "add1_logical" "Increment x_i if y_i is true"
 @timeit (for n=1:100 devec_add1_logical!(x,logical_y) end) "devec_add1_logical" "Devectorized increment x_i if y_i is true"
 
+
+# type inference of a large method with many variables and branches
+function big_method_expr(name, n)
+    body = Expr(:block, :(s = 0), :(x0 = a))
+    for i = 1:n
+        xi = symbol("x$i")
+        xp = symbol("x$(i-1)")
+        push!(body.args, :($xi = $xp + $i))
+        push!(body.args, :(if $xi > b; s += $xi; else; s -= 1; end))
+    end
+    push!(body.args, :s)
+    :(function $name(a, b) $body end)
+end
+
+bigf = nothing
+@timeit_init code_typed(bigf, (Int, Int)) (bigf = eval(big_method_expr(gensym("bigf"), 1000))) "infer_big" "Type inference of a method with 1000 variables"
+
+# interning many distinct symbols, as when reading keys from data
+function intern_symbols(names)
+    s = 0
+    for nm in names
+        s += length(string(symbol(nm)))
+    end
+    s
+end
+
+# each trial interns names not seen before, so no trial only looks them up
+symround = 0
+symnames = nothing
+@timeit_init intern_symbols(symnames) (symround += 1; symnames = [ string("key_", symround, "_", i) for i = 1:200_000 ]) "symbols" "Interning 200000 new symbols"
+
+# front end throughput: parse every file in base
+function parse_all(srcs)
+    for s in srcs
+        pos = 1
+        while !done(s, pos)
+            ex, pos = parse(s, pos)
+        end
+    end
+end
+
+basedir = joinpath(JULIA_HOME, "..", "share", "julia", "base")
+basesrcs = [readall(joinpath(basedir, f)) for f in filter(f->endswith(f, ".jl"), readdir(basedir))]
+@timeit parse_all(basesrcs) "parse_base" "Parsing all of base/*.jl"
+
+# loading source: parsing, lowering and evaluating the forms of a module
+function gen_module_src(n)
+    io = IOBuffer()
+    println(io, "module ", gensym("LoadBench"))
+    for i = 1:n
+        println(io, "f$i(x::Int, y) = x < y ? f$i(y, x) : (x + $i) * y")
+        println(io, "type T$i; a::Int; b::Vector{Float64}; end")
+    end
+    println(io, "end")
+    takebuf_string(io)
+end
+
+loadfile = tempname()
+@timeit_init include(loadfile) (open(io->write(io, gen_module_src(1000)), loadfile, "w")) "include_module" "Loading a file defining 2000 methods and types"
+rm(loadfile)
+
+# reading one field of an array of records: array-of-structs vs struct-of-arrays
+immutable Particle
+    x::Float64
+    y::Float64
+    z::Float64
+    vx::Float64
+    vy::Float64
+    vz::Float64
+end
+
+function sum_x(ps::AbstractVector{Particle})
+    s = 0.0
+    @inbounds for i = 1:length(ps)
+        s += ps[i].x
+    end
+    s
+end
+
+particles = [Particle(rand(), rand(), rand(), 0.0, 0.0, 0.0) for i = 1:10^6]
+particles_soa = convert(StructOfArrays, particles)
+@timeit (for n=1:10 sum_x(particles) end) "field_aos" "Sum one field of an array of immutables"
+@timeit (for n=1:10 sum_x(particles_soa) end) "field_soa" "Sum one field of a StructOfArrays of immutables"
+
+# Dict{ASCIIString,Int}: insertion, lookup (hits and misses) and deletion
+function dict_insert(ks)
+    d = Dict{ASCIIString,Int}()
+    for i = 1:length(ks)
+        d[ks[i]] = i
+    end
+    d
+end
+
+function dict_lookup(d, ks)
+    s = 0
+    for k in ks
+        s += get(d, k, 0)
+    end
+    s
+end
+
+function dict_delete(d, ks)
+    for k in ks
+        delete!(d, k)
+    end
+    d
+end
+
+dictkeys = [string("key", i) for i = 1:10^6]
+misskeys = [string("absent", i) for i = 1:10^6]
+dictd = dict_insert(dictkeys)
+@timeit dict_insert(dictkeys) "dict_insert" "Insert 10^6 string keys into a Dict"
+@timeit dict_lookup(dictd, dictkeys) "dict_lookup" "Look up 10^6 present string keys"
+@timeit dict_lookup(dictd, misskeys) "dict_lookup_miss" "Look up 10^6 absent string keys"
+@timeit_init dict_delete(d, dictkeys) (d = dict_insert(dictkeys)) "dict_delete" "Delete 10^6 string keys from a Dict"
+
+# UTF-8 scanning
+utf8text = utf8(repeat("Julia räknar snabbt — ∀x∈ℝ, plain ascii runs too. ", 20000))
+@timeit length(utf8text) "utf8_length" "Count the characters of a 1MB UTF8String"
+@timeit is_valid_utf8(utf8text.data) "utf8_valid" "Validate 1MB of UTF-8"
+
+# float parsing and printing
+function parse_floats(strs)
+    s = 0.0
+    for x in strs
+        s += float64(x)
+    end
+    s
+end
+
+function print_floats(io, xs)
+    for x in xs
+        print_shortest(io, x)
+        write(io, ',')
+    end
+    takebuf_array(io)
+end
+
+floatvals = rand(10^6)
+floatstrs = split(bytestring(print_floats(IOBuffer(), floatvals)), ',', false)
+@timeit parse_floats(floatstrs) "float_parse" "Parse 10^6 floats from substrings"
+@timeit print_floats(IOBuffer(), floatvals) "float_print" "Print 10^6 floats to an IOBuffer"
+
+# fused broadcasting
+bca, bcb, bcc = rand(10^7), rand(10^7), rand(10^7)
+bcd = similar(bca)
+@timeit bca .* bcb .+ bcc "broadcast_unfused" "Evaluate a .* b .+ c with a temporary"
+@timeit (@broadcast bcd bca .* bcb .+ bcc) "broadcast_fused" "Evaluate a .* b .+ c in one loop into a preallocated array"
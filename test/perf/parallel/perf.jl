@@ -0,0 +1,32 @@
+include("../perfutil.jl")
+
+addprocs(1)
+const wid = workers()[1]
+
+# small-message throughput between two local processes
+
+function remotecall_fetch_loop(n)
+    for i = 1:n
+        remotecall_fetch(wid, identity, i)
+    end
+end
+
+function remotecall_async(n)
+    @sync for i = 1:n
+        @async remotecall_fetch(wid, identity, i)
+    end
+end
+
+function remote_do_loop(n)
+    for i = 1:n
+        remote_do(wid, identity, i)
+    end
+    remotecall_fetch(wid, identity, 0)
+end
+
+@timeit remotecall_fetch_loop(10^4) "remotecall_fetch" "Sequential remotecall_fetch of a tiny function"
+@timeit remotecall_async(10^4) "remotecall_async" "Concurrent remotecall_fetch from many tasks"
+@timeit remote_do_loop(10^4) "remote_do" "remote_do of a tiny function"
+@timeit pmap(identity, 1:10^4) "pmap_small" "pmap over tiny items"
+
+rmprocs(wid)
@@ -0,0 +1,42 @@
+include("../perfutil.jl")
+
+immutable Point3D
+    x::Float64
+    y::Float64
+    z::Float64
+end
+
+type Record
+    id::Int
+    name::ASCIIString
+    pos::Point3D
+    tags::Vector{Symbol}
+end
+
+function roundtrip(x, n, session::Bool)
+    wr = IOBuffer()
+    rd = IOBuffer()
+    if session
+        Base.open_ser_session(wr)
+        Base.open_ser_session(rd)
+    end
+    for i = 1:n
+        serialize(wr, x)
+    end
+    write(rd, takebuf_array(wr))
+    for i = 1:n
+        deserialize(rd)
+    end
+    Base.close_ser_session(wr)
+    Base.close_ser_session(rd)
+end
+
+records = [Record(i, "record$i", Point3D(i, 2i, 3i), [:a, :bb, :ccc]) for i = 1:1000]
+points = [Point3D(rand(), rand(), rand()) for i = 1:10^6]
+msgs = {(i, :call_fetch, identity, (i, 1.0)) for i = 1:1000}
+
+@timeit roundtrip(records, 10, false) "ser_records" "Serialize/deserialize an array of small records"
+@timeit roundtrip(records, 10, true) "ser_records_session" "Serialize/deserialize an array of small records within a session"
+@timeit roundtrip(points, 1, false) "ser_isbits_structs" "Serialize/deserialize an array of isbits immutables"
+@timeit roundtrip(msgs, 10, false) "ser_messages" "Serialize/deserialize small call messages"
+@timeit roundtrip(msgs, 10, true) "ser_messages_session" "Serialize/deserialize small call messages within a session"
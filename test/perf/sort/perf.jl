@@ -1,4 +1,4 @@
-import Base.Sort: QuickSort, MergeSort, InsertionSort
+import Base.Sort: QuickSort, MergeSort, InsertionSort, RadixSort
 
 Pkg.add("SortingAlgorithms")
 using SortingAlgorithms #Provides the other sorting algorithms
@@ -11,6 +11,17 @@ end
 @test isequaldlm(readdlm(IOBuffer("1\t2\n3\t4\n5\t6\n")), [1. 2; 3 4; 5 6], Float64)
 @test isequaldlm(readdlm(IOBuffer("1\t2\n3\t4\n5\t6\n"), Int), [1 2; 3 4; 5 6], Int)
 
+# numeric data is parsed straight into columns; anything irregular falls back
+@test isequaldlm(readcsv(IOBuffer("1.5,-2e3,\"3\"\r\n4,5,6\r\n")), [1.5 -2000. 3.; 4. 5. 6.], Float64)
+@test isequaldlm(readcsv(IOBuffer("1,2\n3,4\n\n")), reshape({1.,3.,"",2.,4.,""}, 3, 2), Any)
+@test isequaldlm(readcsv(IOBuffer("1,2\n3,x\n")), reshape({1.,3.,2.,"x"}, 2, 2), Any)
+@test isequaldlm(readcsv(IOBuffer("1,2\n3,4,5\n")), reshape({1.,3.,2.,4.,"",5.}, 2, 3), Any)
+let io = IOBuffer("a,\"b\"\n1,2\n3,4\n")
+    (data, hdr) = readcsv(io, header=true)
+    @test isequaldlm(data, [1. 2.; 3. 4.], Float64)
+    @test hdr == ["a" "b"]
+end
+
 @test size(readcsv(IOBuffer("1,2,3,4"))) == (1,4)
 @test size(readcsv(IOBuffer("1,2,3,"))) == (1,4)
 @test size(readcsv(IOBuffer("1,2,3,4\n"))) == (1,4)
@@ -8,7 +8,8 @@ testnames = [
     "resolve", "pollfd", "mpfr", "broadcast", "complex", "socket",
     "floatapprox", "readdlm", "regex", "float16", "combinatorics",
     "sysinfo", "rounding", "ranges", "mod2pi", "euler", "show",
-    "lineedit", "replcompletions", "repl", "test"
+    "lineedit", "replcompletions", "repl", "test", "inferencecache",
+    "serialize"
 ]
 @unix_only push!(testnames, "unicode")
 
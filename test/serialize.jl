@@ -0,0 +1,84 @@
+# serializer sessions
+
+immutable SerTestPoint
+    x::Float64
+    y::Int32
+end
+
+type SerTestBox
+    a
+    b::Symbol
+end
+
+sertest_vals = {SerTestPoint(1.5, int32(2)), SerTestBox(SerTestPoint(0.0, int32(-1)), :sertest_sym),
+                SerTestPoint, :sertest_sym, Base.Sort, [SerTestPoint(2.0, int32(3)) for i = 1:3]}
+
+function sertest_check(vals)
+    @test vals[1] === SerTestPoint(1.5, int32(2))
+    @test isa(vals[2], SerTestBox) && vals[2].a === SerTestPoint(0.0, int32(-1)) &&
+          vals[2].b === :sertest_sym
+    @test vals[3] === SerTestPoint
+    @test vals[4] === :sertest_sym
+    @test vals[5] === Base.Sort
+    @test isa(vals[6], Vector{SerTestPoint}) && vals[6] == [SerTestPoint(2.0, int32(3)) for i = 1:3]
+end
+
+function sertest_write(io)
+    for v in sertest_vals
+        serialize(io, v)
+    end
+    takebuf_array(io)
+end
+
+function sertest_read(data::Vector{Uint8}...)
+    io = IOBuffer([data...])
+    Base.open_ser_session(io)
+    vals = {}
+    for i = 1:length(data)*length(sertest_vals)
+        push!(vals, deserialize(io))
+    end
+    Base.close_ser_session(io)
+    vals
+end
+
+# raw isbits immutables, without a session
+io = IOBuffer()
+serialize(io, SerTestPoint(-2.25, int32(7)))
+@test deserialize(IOBuffer(takebuf_array(io))) === SerTestPoint(-2.25, int32(7))
+
+# one stream: types, symbols and modules seen before are sent by reference
+w = IOBuffer()
+Base.open_ser_session(w)
+data1 = sertest_write(w)
+data2 = sertest_write(w)
+Base.close_ser_session(w)
+@test length(data2) < length(data1)
+vals = sertest_read(data1, data2)
+sertest_check(vals[1:6])
+sertest_check(vals[7:12])
+
+# two streams have independent sessions: each defines what it refers to
+w1 = IOBuffer(); w2 = IOBuffer()
+Base.open_ser_session(w1); Base.open_ser_session(w2)
+a1 = sertest_write(w1)
+b1 = sertest_write(w2)
+a2 = sertest_write(w1)
+Base.close_ser_session(w1); Base.close_ser_session(w2)
+@test length(b1) == length(a1)
+sertest_check(sertest_read(b1))
+vals = sertest_read(a1, a2)
+sertest_check(vals[1:6])
+sertest_check(vals[7:12])
+
+# a closed session no longer refers back
+w = IOBuffer()
+Base.open_ser_session(w)
+sertest_write(w)
+Base.close_ser_session(w)
+plain = sertest_write(w)
+vals = {}
+r = IOBuffer(plain)
+for i = 1:6
+    push!(vals, deserialize(r))
+end
+sertest_check(vals)
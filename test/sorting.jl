@@ -92,6 +92,19 @@ for alg in [InsertionSort, MergeSort]
     @test b == c
 end
 
+b = sort(a, alg=RadixSort)
+@test b == sort(a)
+@test sort(a, alg=RadixSort, rev=true) == sort(a, rev=true)
+@test sort(a, alg=RadixSort, by=x->1/x) == sort(a, alg=MergeSort, by=x->1/x)
+@test sortperm(a, alg=RadixSort) == sortperm(a, alg=MergeSort)
+@test sort(a-5000, alg=RadixSort) == sort(a-5000)
+@test sort(uint8(a%256), alg=RadixSort) == sort(uint8(a%256))
+let b = [int128(x)<<80 for x in a]
+    @test sort(b, alg=RadixSort) == sort(b)
+end
+@test sort(float32(a-5000)/7, alg=RadixSort) == sort(float32(a-5000)/7)
+@test_throws ErrorException sort(a, alg=RadixSort, lt=(>))
+
 b = sort(a, alg=QuickSort)
 @test issorted(b)
 b = sort(a, alg=QuickSort, rev=true)
@@ -136,7 +149,7 @@ for n in [0:10, 100, 101, 1000, 1001]
         @test c == v
 
         # stable algorithms
-        for alg in [MergeSort]
+        for alg in [MergeSort, RadixSort]
             p = sortperm(v, alg=alg, rev=rev)
             @test p == sortperm(float(v), alg=alg, rev=rev)
             @test p == pi
@@ -162,7 +175,7 @@ for n in [0:10, 100, 101, 1000, 1001]
     end
 
     v = randn_with_nans(n,0.1)
-    for alg in [InsertionSort, QuickSort, MergeSort],
+    for alg in [InsertionSort, QuickSort, MergeSort, RadixSort],
         rev in [false,true]
         # test float sorting with NaNs
         s = sort(v, alg=alg, rev=rev)
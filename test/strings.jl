@@ -474,6 +474,13 @@ end
 @test rsearch("foo,bar,baz", "az") == 10:11
 @test rsearch("foo,bar,baz", "az", 10) == 0:-1
 
+# array search, with near misses on the first byte
+@test search(Uint8[1,2,1,2,3],Uint8[1,2,3],1) == 3:5
+@test search(Uint8[1,2,1,2,3],Uint8[1,2,3],4) == 0:-1
+@test search(Int8[-1,-1,-1,2],Int8[-1,2],1) == 3:4
+@test search(Uint8[1,2,3],Uint8[3,4],1) == 0:-1
+@test searchindex("aaaaaaaaab", "aab") == 8
+
 # array rsearch
 @test rsearch(Uint8[1,2,3],Uint8[2,3],3) == 2:3
 @test rsearch(Uint8[1,2,3],Uint8[2,3],1) == 0:-1
@@ -569,6 +576,20 @@ end
 @test isequal(split("abcd", r"d+"), ["abc",""])
 @test isequal(split("abcd", r"[ad]?"), ["","b","c",""])
 
+# eachsplit yields the same pieces as split
+for (str, spl) in {("foo,bar,baz", ','), ("foo,bar,baz", "x"), ("", ','),
+                   (",,", ','), ("a.:.ba..:..cba.:.:.dcba.:.", ".:."),
+                   ("abc", ""), ("abcd", r"b?"), ("abcd", r"[bc]?"),
+                   ("abcd", r"a*"), ("abcd", r"[ad]?")}
+    for keep in (true, false)
+        @test isequal(collect(eachsplit(str, spl, keep)), split(str, spl, keep))
+    end
+end
+@test isequal(collect(eachsplit("a  b \t c\n")), ["a","b","c"])
+@test eltype(eachsplit("a,b", ',')) == SubString{ASCIIString}
+@test eltype(eachsplit(SubString("a,b",1), ',')) == SubString{ASCIIString}
+@test [float64(x) for x in eachsplit("1.5,2,-3e2", ',')] == [1.5,2.0,-300.0]
+
 # replace
 @test replace("foobar", 'o', '0') == "f00bar"
 @test replace("foobar", 'o', '0', 1) == "f0obar"
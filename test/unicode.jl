@@ -24,6 +24,34 @@ w = wstring(u8)
 @test length(w) == 4 && utf8(w) == u8 && collect(u8) == collect(w)
 @test u8 == WString(w.data)
 
+# UTF-8 length and validity, with each sequence at every offset across
+# the 8-byte words they are checked in
+for n = 0:17
+    pad = fill(uint8('a'), n)
+    @test length(UTF8String(pad)) == n
+    @test is_valid_ascii(pad)
+    for seq in ("é", "∀", "\U1d565")
+        b = seq.data; m = length(b)
+        for k = 1:n-m+1
+            d = copy(pad); d[k:k+m-1] = b
+            @test length(UTF8String(d)) == n-m+1
+            @test is_valid_utf8(d) && !is_valid_ascii(d)
+        end
+        # missing its last continuation byte
+        for k = 1:n-m+2
+            d = copy(pad); d[k:k+m-2] = b[1:m-1]
+            @test length(UTF8String(d)) == n-m+2
+            @test !is_valid_utf8(d)
+        end
+    end
+    # stray continuation byte
+    for k = 1:n
+        d = copy(pad); d[k] = 0x80
+        @test length(UTF8String(d)) == n-1
+        @test !is_valid_utf8(d)
+    end
+end
+
 if !success(`iconv --version`)
     warn("iconv not found, skipping unicode tests!")
     @windows_only warn("Use WinRPM.install(\"win_iconv\") to run these tests")